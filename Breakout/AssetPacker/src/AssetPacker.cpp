@@ -0,0 +1,214 @@
+// Offline tool building the game's asset pack.
+//
+// Usage: AssetPacker <output.pak> <file | @listfile>...
+//
+// Files are stored under the path they are given with (use the same relative paths the game loads them from,
+// e.g. "res/shaders/sprite.vs"). A list file holds one path per line.
+// Shaders (.vs .fs .gs .vert .frag .geom .glsl) are stored null-terminated, images (.png .jpg .jpeg .bmp .tga)
+// are decoded and flipped vertically the way the game expects them, anything else is stored raw.
+
+#include <AssetPackFormat.h>
+
+#include <stb_image/stb_image.h>
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace AssetPackFormat;
+
+namespace
+{
+    struct PendingEntry
+    {
+        std::string Name;
+        PackEntry Entry{};
+        std::vector<unsigned char> Data;
+    };
+
+    std::string GetExtension(const std::string& path)
+    {
+        const size_t dot = path.find_last_of('.');
+        if (dot == std::string::npos)
+            return {};
+
+        std::string extension = path.substr(dot + 1);
+        std::transform(extension.begin(), extension.end(), extension.begin(), [](const unsigned char c) { return static_cast<char>(std::tolower(c)); });
+        return extension;
+    }
+
+    EntryType GetEntryType(const std::string& path)
+    {
+        const std::string extension = GetExtension(path);
+        for (const char* shaderExtension : { "vs", "fs", "gs", "vert", "frag", "geom", "glsl" })
+        {
+            if (extension == shaderExtension)
+                return EntryType::Shader;
+        }
+        for (const char* imageExtension : { "png", "jpg", "jpeg", "bmp", "tga" })
+        {
+            if (extension == imageExtension)
+                return EntryType::Texture;
+        }
+        return EntryType::Raw;
+    }
+
+    bool ReadFile(const std::string& path, std::vector<unsigned char>& outData)
+    {
+        std::ifstream file(path, std::ios::binary);
+        if (!file)
+            return false;
+
+        std::stringstream stream;
+        stream << file.rdbuf();
+        const std::string content = stream.str();
+        outData.assign(content.begin(), content.end());
+        return true;
+    }
+
+    bool LoadEntry(const std::string& path, PendingEntry& outEntry)
+    {
+        outEntry.Name = path;
+        std::replace(outEntry.Name.begin(), outEntry.Name.end(), '\\', '/');
+        outEntry.Entry.Type = GetEntryType(path);
+
+        if (outEntry.Entry.Type == EntryType::Texture)
+        {
+            int width, height, channels;
+            unsigned char* pixels = stbi_load(path.c_str(), &width, &height, &channels, 0);
+            if (pixels == nullptr)
+            {
+                std::cout << "[ERROR] AssetPacker: Failed to decode '" << path << "'. Error: " << stbi_failure_reason() << '\n';
+                return false;
+            }
+
+            outEntry.Entry.Width = width;
+            outEntry.Entry.Height = height;
+            outEntry.Entry.Channels = channels;
+            outEntry.Data.assign(pixels, pixels + static_cast<size_t>(width) * height * channels);
+            stbi_image_free(pixels);
+            return true;
+        }
+
+        if (!ReadFile(path, outEntry.Data))
+        {
+            std::cout << "[ERROR] AssetPacker: Failed to read '" << path << "'" << '\n';
+            return false;
+        }
+
+        if (outEntry.Entry.Type == EntryType::Shader)
+            outEntry.Data.push_back('\0');
+        return true;
+    }
+
+    uint64_t Align(const uint64_t offset)
+    {
+        return (offset + BlobAlignment - 1) & ~(BlobAlignment - 1);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 3)
+    {
+        std::cout << "Usage: AssetPacker <output.pak> <file | @listfile>..." << '\n';
+        return 1;
+    }
+
+    std::vector<std::string> paths;
+    for (int i = 2; i < argc; i++)
+    {
+        if (argv[i][0] != '@')
+        {
+            paths.emplace_back(argv[i]);
+            continue;
+        }
+
+        std::ifstream list(argv[i] + 1);
+        if (!list)
+        {
+            std::cout << "[ERROR] AssetPacker: Failed to read list file '" << (argv[i] + 1) << "'" << '\n';
+            return 1;
+        }
+
+        std::string line;
+        while (std::getline(list, line))
+        {
+            line.erase(line.find_last_not_of(" \t\r") + 1);
+            if (!line.empty() && line[0] != '#')
+                paths.push_back(line);
+        }
+    }
+
+    // Sorted so that the same inputs always produce the same pack
+    std::sort(paths.begin(), paths.end());
+    paths.erase(std::unique(paths.begin(), paths.end()), paths.end());
+
+    stbi_set_flip_vertically_on_load(1);
+
+    std::vector<PendingEntry> entries(paths.size());
+    for (size_t i = 0; i < paths.size(); i++)
+    {
+        if (!LoadEntry(paths[i], entries[i]))
+            return 1;
+    }
+
+    // Layout: header, table of contents, names, aligned blobs
+    PackHeader header{};
+    header.Magic = Magic;
+    header.Version = Version;
+    header.EntryCount = static_cast<uint32_t>(entries.size());
+    header.TocOffset = sizeof(PackHeader);
+    header.NamesOffset = header.TocOffset + entries.size() * sizeof(PackEntry);
+
+    std::string names;
+    for (PendingEntry& entry : entries)
+    {
+        entry.Entry.NameOffset = static_cast<uint32_t>(names.size());
+        entry.Entry.NameLength = static_cast<uint32_t>(entry.Name.size());
+        names += entry.Name;
+    }
+
+    uint64_t offset = header.NamesOffset + names.size();
+    for (PendingEntry& entry : entries)
+    {
+        offset = Align(offset);
+        entry.Entry.DataOffset = offset;
+        entry.Entry.DataSize = entry.Data.size();
+        offset += entry.Data.size();
+    }
+
+    std::ofstream output(argv[1], std::ios::binary | std::ios::trunc);
+    if (!output)
+    {
+        std::cout << "[ERROR] AssetPacker: Failed to create '" << argv[1] << "'" << '\n';
+        return 1;
+    }
+
+    output.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    for (const PendingEntry& entry : entries)
+        output.write(reinterpret_cast<const char*>(&entry.Entry), sizeof(PackEntry));
+    output.write(names.data(), static_cast<std::streamsize>(names.size()));
+
+    const char padding[BlobAlignment] = {};
+    for (const PendingEntry& entry : entries)
+    {
+        const auto position = static_cast<uint64_t>(output.tellp());
+        output.write(padding, static_cast<std::streamsize>(entry.Entry.DataOffset - position));
+        output.write(reinterpret_cast<const char*>(entry.Data.data()), static_cast<std::streamsize>(entry.Data.size()));
+    }
+
+    if (!output)
+    {
+        std::cout << "[ERROR] AssetPacker: Failed to write '" << argv[1] << "'" << '\n';
+        return 1;
+    }
+
+    std::cout << "| [INFO] AssetPacker: Packed " << entries.size() << " entries into '" << argv[1] << "' (" << offset << " bytes)" << '\n';
+    return 0;
+}
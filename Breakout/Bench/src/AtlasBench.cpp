@@ -0,0 +1,52 @@
+// TextureAtlas packing thousands of small sprites, on the null backend so that only packing and copying are measured
+
+#include "Bench.h"
+
+#include <Renderer/NullRendererAPI.h>
+#include <Renderer/TextureAtlas.h>
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace
+{
+    struct Sprite
+    {
+        std::string Name;
+        int Width, Height;
+    };
+}
+
+BENCHMARK(TextureAtlasBuild)
+{
+    RendererAPI::Create(RendererAPI::API::Null);
+    auto& recorder = static_cast<NullRendererAPI&>(RendererAPI::Get());
+
+    for (const uint32_t spriteCount : { 1000u, 5000u })
+    {
+        // 4 to 64 texels a side, the same set for every run
+        std::vector<Sprite> sprites;
+        Harness::Random random(42);
+        for (uint32_t i = 0; i < spriteCount; i++)
+        {
+            const uint32_t size = random.Next();
+            const int width = 4 + static_cast<int>(size % 61);
+            const int height = 4 + static_cast<int>((size >> 12) % 61);
+            sprites.push_back({ "sprite_" + std::to_string(i), width, height });
+        }
+        const std::vector<unsigned char> pixels(64 * 64 * 4, 255);
+
+        uint32_t pages = 0;
+        Bench::Measure("Add + Build, " + std::to_string(spriteCount) + " sprites (per sprite)", spriteCount, [&]()
+        {
+            TextureAtlas atlas;
+            for (const Sprite& sprite : sprites)
+                atlas.Add(sprite.Name, pixels.data(), sprite.Width, sprite.Height, 4);
+            atlas.Build();
+            pages = atlas.GetPageCount();
+            recorder.Reset();
+        });
+        std::cout << "| [INFO] Bench: " << spriteCount << " sprites packed into " << pages << " 2048x2048 page(s)" << '\n';
+    }
+}
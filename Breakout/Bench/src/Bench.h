@@ -0,0 +1,43 @@
+#pragma once
+
+#include <Harness.h>
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+// Minimal benchmark runner on top of the shared Harness: cases time their own loops with Measure, one result line
+// each. Numbers are only meaningful in Release builds.
+namespace Bench
+{
+    // Each measurement repeats its function for at least this long
+    constexpr double MinimumSeconds = 0.25;
+
+    void Report(const std::string& label, double nanosecondsPerOperation);
+    // Keeps the compiler from dropping computations whose result nothing else reads
+    void Consume(uint64_t value);
+
+    // Calls function once untimed, then again until MinimumSeconds have passed. Reports and returns the time per
+    // operation, each call doing operations of them.
+    template<typename Function>
+    double Measure(const std::string& label, const uint64_t operations, Function&& function)
+    {
+        function();
+
+        uint64_t calls = 0;
+        double seconds = 0.0;
+        const auto start = std::chrono::steady_clock::now();
+        do
+        {
+            function();
+            calls++;
+            seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        } while (seconds < MinimumSeconds);
+
+        const double nanoseconds = seconds * 1e9 / (static_cast<double>(calls) * static_cast<double>(operations));
+        Report(label, nanoseconds);
+        return nanoseconds;
+    }
+}
+
+#define BENCHMARK(name) HARNESS_CASE(name)
@@ -0,0 +1,34 @@
+// Usage: Bench [name filter]
+
+#include "Bench.h"
+
+#include <atomic>
+#include <iomanip>
+#include <iostream>
+
+namespace
+{
+    std::atomic<uint64_t> s_Sink{ 0 };
+}
+
+void Bench::Report(const std::string& label, const double nanosecondsPerOperation)
+{
+    std::cout << "| [INFO] Bench: " << std::left << std::setw(56) << label << std::right << std::fixed << std::setprecision(2)
+        << std::setw(12) << nanosecondsPerOperation << " ns/op" << '\n';
+}
+
+void Bench::Consume(const uint64_t value)
+{
+    s_Sink.fetch_add(value, std::memory_order_relaxed);
+}
+
+int main(int argc, char** argv)
+{
+    Harness::RunCases(argc, argv, [](const Harness::Case& benchmark)
+    {
+        std::cout << "| [INFO] Bench: " << benchmark.Name << '\n';
+        benchmark.Run();
+    });
+
+    return 0;
+}
@@ -0,0 +1,85 @@
+// BrickGrid queries on a 100k brick stress level, against a scan of every brick as the no-broad-phase baseline
+
+#include "Bench.h"
+
+#include <Level/BrickGrid.h>
+
+#include <glm/glm.hpp>
+
+#include <iostream>
+#include <vector>
+
+namespace
+{
+    constexpr uint32_t Columns = 317, Rows = 316; // 100,172 cells
+    constexpr uint32_t BallCount = 1000;
+    const glm::vec2 s_Origin(-10.0f, 5.0f);
+    const glm::vec2 s_CellSize(4.0f, 2.0f);
+
+    Harness::Random s_Random(7);
+}
+
+BENCHMARK(BrickGridQueries)
+{
+    // About a third of the cells are left empty
+    BrickGrid grid(Columns, Rows, s_Origin, s_CellSize);
+    for (uint32_t row = 0; row < Rows; row++)
+        for (uint32_t column = 0; column < Columns; column++)
+            grid.SetBrick(column, row, static_cast<uint8_t>(s_Random.Next() % 3), 0.1f);
+
+    const glm::vec2 fieldMax = s_Origin + s_CellSize * glm::vec2(Columns, Rows);
+    std::vector<glm::vec2> balls(BallCount);
+    for (glm::vec2& ball : balls)
+        ball = { s_Random.NextFloat(s_Origin.x, fieldMax.x), s_Random.NextFloat(s_Origin.y, fieldMax.y) };
+
+    std::cout << "| [INFO] Bench: " << grid.GetAliveCount() << " live bricks" << '\n';
+
+    std::vector<uint32_t> found;
+    found.reserve(static_cast<size_t>(grid.GetStride()) * Rows);
+
+    // A ball of radius 1.5 moving (3, 2) in a tick, about the size of a real one against these cells
+    Bench::Measure("QuerySwept, one tick of ball movement (per ball)", BallCount, [&]()
+    {
+        uint64_t total = 0;
+        for (const glm::vec2& ball : balls)
+        {
+            found.clear();
+            grid.QuerySwept(ball, ball + glm::vec2(3.0f, 2.0f), 1.5f, found);
+            total += found.size();
+        }
+        Bench::Consume(total);
+    });
+
+    // Wide boxes stress the per-row vector tests rather than the cell lookup
+    Bench::Measure("QueryOverlaps, 64x64 box (per query)", BallCount, [&]()
+    {
+        uint64_t total = 0;
+        for (const glm::vec2& ball : balls)
+        {
+            found.clear();
+            grid.QueryOverlaps(ball, ball + glm::vec2(64.0f), found);
+            total += found.size();
+        }
+        Bench::Consume(total);
+    });
+
+    // What a ball would cost without the grid: every live brick tested against the swept bounds
+    const uint32_t bricks = grid.GetStride() * Rows;
+    Bench::Measure("Scan of every brick, one tick of ball movement (per ball)", 10, [&]()
+    {
+        uint64_t total = 0;
+        for (uint32_t b = 0; b < 10; b++)
+        {
+            const glm::vec2 min = glm::min(balls[b], balls[b] + glm::vec2(3.0f, 2.0f)) - 1.5f;
+            const glm::vec2 max = glm::max(balls[b], balls[b] + glm::vec2(3.0f, 2.0f)) + 1.5f;
+            for (uint32_t brick = 0; brick < bricks; brick++)
+            {
+                if (!grid.IsAlive(brick))
+                    continue;
+                const glm::vec2 brickMin = grid.GetMin(brick), brickMax = grid.GetMax(brick);
+                total += brickMin.x <= max.x && brickMax.x >= min.x && brickMin.y <= max.y && brickMax.y >= min.y;
+            }
+        }
+        Bench::Consume(total);
+    });
+}
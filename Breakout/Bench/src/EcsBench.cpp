@@ -0,0 +1,106 @@
+// Registry iteration at 100k entities against the object list it replaces: heap allocated GameObjects behind virtual
+// Update calls, in the scattered order a list built and churned over a level ends up in
+
+#include "Bench.h"
+
+#include <ECS/Registry.h>
+
+#include <glm/glm.hpp>
+
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace
+{
+    constexpr uint32_t EntityCount = 100000;
+    constexpr float TickDuration = 1.0f / 120.0f;
+
+    struct Transform { glm::vec2 Position; };
+    struct Velocity { glm::vec2 Value; };
+    struct Health { int Value; };
+
+    // The baseline, sized like a typical game object with a few more fields than the loop touches
+    class GameObject
+    {
+    public:
+        virtual ~GameObject() = default;
+        virtual void Update(float deltaTime) = 0;
+
+        glm::vec2 Position = glm::vec2(0.0f);
+        glm::vec2 Velocity = glm::vec2(1.0f, 2.0f);
+        int Health = 3;
+        glm::vec4 Color = glm::vec4(1.0f);
+        glm::vec2 Size = glm::vec2(1.0f);
+    };
+
+    class Ball : public GameObject
+    {
+    public:
+        void Update(const float deltaTime) override { Position += Velocity * deltaTime; }
+    };
+
+    class PowerUp : public GameObject
+    {
+    public:
+        void Update(const float deltaTime) override { Position.y += Velocity.y * deltaTime; }
+    };
+}
+
+BENCHMARK(EcsIteration)
+{
+    Registry registry;
+    for (uint32_t i = 0; i < EntityCount; i++)
+    {
+        const Entity entity = registry.Create();
+        registry.Add<Transform>(entity, Transform{ glm::vec2(static_cast<float>(i), 0.0f) });
+        registry.Add<Velocity>(entity, Velocity{ glm::vec2(1.0f, 2.0f) });
+        registry.Add<Health>(entity, Health{ 3 });
+    }
+
+    std::mt19937 random(1);
+    std::vector<std::unique_ptr<GameObject>> objects;
+    objects.reserve(EntityCount);
+    for (uint32_t i = 0; i < EntityCount; i++)
+    {
+        if (random() % 4 == 0)
+            objects.push_back(std::make_unique<PowerUp>());
+        else
+            objects.push_back(std::make_unique<Ball>());
+    }
+    std::shuffle(objects.begin(), objects.end(), random);
+
+    Bench::Measure("Registry::Each<Transform, Velocity> (per entity)", EntityCount, [&]()
+    {
+        registry.Each<Transform, Velocity>([](Entity, Transform& transform, const Velocity& velocity)
+        {
+            transform.Position += velocity.Value * TickDuration;
+        });
+    });
+
+    Bench::Measure("Registry::Each<Transform> (per entity)", EntityCount, [&]()
+    {
+        registry.Each<Transform>([](Entity, Transform& transform)
+        {
+            transform.Position.y -= TickDuration;
+        });
+    });
+
+    // Pools filled in the same order keep matching slots, so a system may walk both packed arrays side by side
+    Bench::Measure("Packed Transform and Velocity arrays (per entity)", EntityCount, [&]()
+    {
+        std::vector<Transform>& transforms = registry.GetPool<Transform>().GetComponents();
+        const std::vector<Velocity>& velocities = registry.GetPool<Velocity>().GetComponents();
+        for (size_t i = 0; i < transforms.size(); i++)
+            transforms[i].Position += velocities[i].Value * TickDuration;
+    });
+
+    Bench::Measure("GameObject list, virtual Update (per object)", EntityCount, [&]()
+    {
+        for (const std::unique_ptr<GameObject>& object : objects)
+            object->Update(TickDuration);
+    });
+
+    Bench::Consume(static_cast<uint64_t>(registry.Get<Transform>(0).Position.x + objects[0]->Position.x));
+}
@@ -0,0 +1,78 @@
+// JobSystem scaling from 1 thread (no workers, jobs run inline) up to one thread per core on a compute bound
+// ParallelFor, and the cost of a single job. Scaling can only show on a machine with several cores.
+
+#include "Bench.h"
+
+#include <Jobs/JobSystem.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    constexpr uint32_t ElementCount = 1 << 20;
+    constexpr uint32_t BatchSize = 4096;
+    constexpr uint32_t JobsPerCall = 1000;
+
+    // Enough arithmetic per element that the loop is not memory bound
+    void Simulate(std::vector<float>& values, const uint32_t begin, const uint32_t end)
+    {
+        for (uint32_t i = begin; i < end; i++)
+        {
+            float value = values[i];
+            for (int step = 0; step < 20; step++)
+                value = std::sqrt(value * 1.0001f + 0.5f);
+            values[i] = value;
+        }
+    }
+}
+
+BENCHMARK(JobSystemScaling)
+{
+    const uint32_t cores = std::max(1u, std::thread::hardware_concurrency());
+    std::cout << "| [INFO] Bench: " << cores << " hardware thread(s)" << '\n';
+
+    std::vector<float> values(ElementCount, 1.0f);
+    double singleThreaded = 0.0;
+    for (uint32_t threads = 1; threads <= cores; threads++)
+    {
+        // The calling thread takes part in ParallelFor, so n threads are n - 1 workers
+        if (threads == 1)
+            JobSystem::Shutdown();
+        else
+            JobSystem::Initialize(threads - 1);
+
+        const double nanoseconds = Bench::Measure("ParallelFor, " + std::to_string(threads) + " thread(s) (per element)", ElementCount, [&]()
+        {
+            JobSystem::ParallelFor(ElementCount, BatchSize, [&values](const uint32_t begin, const uint32_t end)
+            {
+                Simulate(values, begin, end);
+            });
+        });
+
+        if (threads == 1)
+            singleThreaded = nanoseconds;
+        else
+            std::cout << "| [INFO] Bench: " << std::fixed << std::setprecision(2) << singleThreaded / nanoseconds << "x speedup over 1 thread" << '\n';
+    }
+
+    // Overhead of Run and Wait around a job that does nothing, with one worker to hand it to
+    JobSystem::Initialize(1);
+    std::atomic<uint64_t> ran{ 0 };
+    Bench::Measure("Run + Wait of an empty job (per job)", JobsPerCall, [&ran]()
+    {
+        JobCounter counter;
+        for (uint32_t i = 0; i < JobsPerCall; i++)
+            JobSystem::Run([&ran]() { ran.fetch_add(1, std::memory_order_relaxed); }, &counter);
+        JobSystem::Wait(counter);
+    });
+    JobSystem::Shutdown();
+
+    Bench::Consume(ran.load() + static_cast<uint64_t>(values[0]));
+}
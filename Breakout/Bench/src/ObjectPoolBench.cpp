@@ -0,0 +1,91 @@
+// ObjectPool stress: a full pool of particles where random ones die and respawn, against new/delete and
+// std::make_shared doing the same, then a pass over the live objects of each
+
+#include "Bench.h"
+
+#include <Memory/ObjectPool.h>
+
+#include <glm/glm.hpp>
+
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace
+{
+    constexpr uint32_t Capacity = 4096;
+    constexpr uint32_t ChurnCount = 1 << 16;
+
+    struct Particle
+    {
+        glm::vec2 Position, Velocity;
+        glm::vec4 Color;
+        float Life;
+    };
+
+    const Particle s_Spawned{ glm::vec2(1.0f), glm::vec2(1.0f), glm::vec4(1.0f), 1.0f };
+}
+
+BENCHMARK(ObjectPoolChurn)
+{
+    // The same slots die in every run
+    std::mt19937 random(1);
+    std::vector<uint32_t> victims(ChurnCount);
+    for (uint32_t& victim : victims)
+        victim = random() % Capacity;
+
+    ObjectPool<Particle> pool(Capacity);
+    std::vector<ObjectPool<Particle>::Handle> handles(Capacity);
+    for (ObjectPool<Particle>::Handle& handle : handles)
+        handle = pool.Create(s_Spawned);
+
+    std::vector<Particle*> heapObjects(Capacity);
+    for (Particle*& object : heapObjects)
+        object = new Particle(s_Spawned);
+
+    std::vector<std::shared_ptr<Particle>> sharedObjects(Capacity);
+    for (std::shared_ptr<Particle>& object : sharedObjects)
+        object = std::make_shared<Particle>(s_Spawned);
+
+    Bench::Measure("ObjectPool Destroy + Create (per pair)", ChurnCount, [&]()
+    {
+        for (const uint32_t victim : victims)
+        {
+            pool.Destroy(handles[victim]);
+            handles[victim] = pool.Create(s_Spawned);
+        }
+    });
+    Bench::Measure("delete + new (per pair)", ChurnCount, [&]()
+    {
+        for (const uint32_t victim : victims)
+        {
+            delete heapObjects[victim];
+            heapObjects[victim] = new Particle(s_Spawned);
+        }
+    });
+    Bench::Measure("std::make_shared replacing a shared_ptr (per pair)", ChurnCount, [&]()
+    {
+        for (const uint32_t victim : victims)
+            sharedObjects[victim] = std::make_shared<Particle>(s_Spawned);
+    });
+
+    // Whatever order the particles died in, the pool's live list stays dense
+    Bench::Measure("ObjectPool ForEach (per object)", Capacity, [&]()
+    {
+        pool.ForEach([](ObjectPool<Particle>::Handle, Particle& particle) { particle.Position += particle.Velocity; });
+    });
+    Bench::Measure("Raw pointers from new (per object)", Capacity, [&]()
+    {
+        for (Particle* particle : heapObjects)
+            particle->Position += particle->Velocity;
+    });
+    Bench::Measure("shared_ptrs from std::make_shared (per object)", Capacity, [&]()
+    {
+        for (const std::shared_ptr<Particle>& particle : sharedObjects)
+            particle->Position += particle->Velocity;
+    });
+
+    Bench::Consume(static_cast<uint64_t>(pool.Get(handles[0])->Position.x + heapObjects[0]->Position.x + sharedObjects[0]->Position.x));
+    for (Particle* object : heapObjects)
+        delete object;
+}
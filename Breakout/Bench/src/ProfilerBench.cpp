@@ -0,0 +1,38 @@
+// Cost of a profiler zone as seen by the code it wraps: two timestamp reads and a store into the thread's ring
+// buffer, against the steady clock reads the zones used to take
+
+#include "Bench.h"
+
+#include <Debug/Profiler.h>
+
+namespace
+{
+    constexpr uint32_t ZonesPerCall = 1000;
+}
+
+BENCHMARK(ProfilerZones)
+{
+    Bench::Measure("PROFILE_SCOPE", ZonesPerCall, []()
+    {
+        for (uint32_t i = 0; i < ZonesPerCall; i++)
+        {
+            const ProfileScope scope("Zone");
+        }
+    });
+
+    Bench::Measure("Profiler::Ticks", ZonesPerCall, []()
+    {
+        uint64_t sum = 0;
+        for (uint32_t i = 0; i < ZonesPerCall; i++)
+            sum += Profiler::Ticks();
+        Bench::Consume(sum);
+    });
+
+    Bench::Measure("Steady clock", ZonesPerCall, []()
+    {
+        uint64_t sum = 0;
+        for (uint32_t i = 0; i < ZonesPerCall; i++)
+            sum += Profiler::SteadyClockNanoseconds();
+        Bench::Consume(sum);
+    });
+}
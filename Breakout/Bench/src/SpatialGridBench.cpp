@@ -0,0 +1,94 @@
+// SpatialGrid broad phase at 10, 1,000 and 100,000 dynamic bodies bouncing around an 800x600 field: moving every body,
+// then each body querying its own bounds, against all-pairs tests where that is still affordable
+
+#include "Bench.h"
+
+#include <Physics/SpatialGrid.h>
+
+#include <glm/glm.hpp>
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace
+{
+    const glm::vec2 s_FieldSize(800.0f, 600.0f);
+    const glm::vec2 s_BodySize(8.0f);
+    constexpr float TickDuration = 1.0f / 120.0f;
+
+    struct Body
+    {
+        glm::vec2 Position, Velocity;
+        uint32_t Handle;
+    };
+
+    Harness::Random s_Random(5);
+}
+
+BENCHMARK(SpatialGridBroadPhase)
+{
+    for (const uint32_t count : { 10u, 1000u, 100000u })
+    {
+        // Smaller cells keep the crowded field at a handful of bodies per cell
+        SpatialGrid grid(s_FieldSize, count >= 100000 ? 8.0f : 32.0f);
+        std::vector<Body> bodies(count);
+        for (Body& body : bodies)
+        {
+            body.Position = { s_Random.NextFloat(0.0f, s_FieldSize.x), s_Random.NextFloat(0.0f, s_FieldSize.y) };
+            body.Velocity = { s_Random.NextFloat(-100.0f, 100.0f), s_Random.NextFloat(-100.0f, 100.0f) };
+            body.Handle = grid.Insert(body.Position, body.Position + s_BodySize);
+        }
+
+        const std::string bodyCount = ", " + std::to_string(count) + " bodies";
+        const std::string suffix = bodyCount + " (per body)";
+        std::vector<uint32_t> found;
+
+        Bench::Measure("Move" + suffix, count, [&]()
+        {
+            for (Body& body : bodies)
+            {
+                body.Position += body.Velocity * TickDuration;
+                if (body.Position.x < 0.0f || body.Position.x > s_FieldSize.x)
+                    body.Velocity.x = -body.Velocity.x;
+                if (body.Position.y < 0.0f || body.Position.y > s_FieldSize.y)
+                    body.Velocity.y = -body.Velocity.y;
+                grid.Move(body.Handle, body.Position, body.Position + s_BodySize);
+            }
+        });
+
+        uint64_t pairs = 0;
+        Bench::Measure("QueryAABB of own bounds" + suffix, count, [&]()
+        {
+            pairs = 0;
+            for (const Body& body : bodies)
+            {
+                found.clear();
+                grid.QueryAABB(body.Position, body.Position + s_BodySize, found);
+                pairs += found.size();
+            }
+        });
+        std::cout << "| [INFO] Bench: " << static_cast<double>(pairs) / count << " bodies found per query" << '\n';
+
+        // A ball's sweep across the field, the way ball against power-up checks use it
+        Bench::Measure("QueryRay across the field" + bodyCount, 1, [&]()
+        {
+            found.clear();
+            grid.QueryRay(glm::vec2(0.0f), s_FieldSize, found);
+            Bench::Consume(found.size());
+        });
+
+        // The quadratic check the grid replaces
+        if (count <= 1000)
+        {
+            Bench::Measure("All pairs" + suffix, count, [&]()
+            {
+                uint64_t overlaps = 0;
+                for (const Body& a : bodies)
+                    for (const Body& b : bodies)
+                        overlaps += glm::all(glm::lessThanEqual(glm::abs(a.Position - b.Position), s_BodySize));
+                Bench::Consume(overlaps);
+            });
+        }
+    }
+}
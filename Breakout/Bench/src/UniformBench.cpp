@@ -0,0 +1,101 @@
+// Shader uniform setters by name (hashed binary search over the active uniforms) against pre-resolved UniformHandles,
+// on the null backend so that only the CPU side is measured. Values change on every call, nothing is skipped by the
+// value shadow.
+
+#include "Bench.h"
+
+#include <Renderer/NullRendererAPI.h>
+#include <Renderer/Shader.h>
+
+#include <glm/glm.hpp>
+
+namespace
+{
+    constexpr uint32_t SetsPerCall = 1000;
+
+    const char* const s_VertexSource = R"(
+        #version 330 core
+        layout (location = 0) in vec2 a_Position;
+        uniform mat4 u_Projection;
+        uniform mat4 u_Model;
+        uniform vec2 u_Offset;
+        uniform float u_Time;
+        uniform float u_Scale;
+        void main() { gl_Position = u_Projection * u_Model * vec4(a_Position * u_Scale + u_Offset + u_Time, 0.0, 1.0); }
+    )";
+
+    const char* const s_FragmentSource = R"(
+        #version 330 core
+        out vec4 o_Color;
+        uniform vec4 u_Color;
+        uniform vec4 u_Tint;
+        uniform sampler2D u_Texture;
+        uniform float u_Alpha;
+        uniform int u_Mode;
+        void main() { o_Color = u_Color * u_Tint * u_Alpha + float(u_Mode); }
+    )";
+}
+
+BENCHMARK(UniformSetters)
+{
+    RendererAPI::Create(RendererAPI::API::Null);
+    auto& recorder = static_cast<NullRendererAPI&>(RendererAPI::Get());
+    const Shader shader(s_VertexSource, s_FragmentSource);
+    shader.Use();
+
+    const UniformHandle time = shader.GetUniformHandle("u_Time");
+    const UniformHandle color = shader.GetUniformHandle("u_Color");
+    const UniformHandle model = shader.GetUniformHandle("u_Model");
+
+    // Wraps well before float precision runs out, so consecutive values always differ
+    uint32_t counter = 0;
+    const auto next = [&counter]() { return static_cast<float>(++counter & 0xFFFF); };
+
+    Bench::Measure("SetFloat by name", SetsPerCall, [&]()
+    {
+        for (uint32_t i = 0; i < SetsPerCall; i++)
+            shader.SetFloat("u_Time", next());
+        recorder.Reset();
+    });
+    Bench::Measure("SetFloat by handle", SetsPerCall, [&]()
+    {
+        for (uint32_t i = 0; i < SetsPerCall; i++)
+            shader.SetFloat(time, next());
+        recorder.Reset();
+    });
+
+    Bench::Measure("SetVector4f by name", SetsPerCall, [&]()
+    {
+        for (uint32_t i = 0; i < SetsPerCall; i++)
+            shader.SetVector4f("u_Color", glm::vec4(next()));
+        recorder.Reset();
+    });
+    Bench::Measure("SetVector4f by handle", SetsPerCall, [&]()
+    {
+        for (uint32_t i = 0; i < SetsPerCall; i++)
+            shader.SetVector4f(color, glm::vec4(next()));
+        recorder.Reset();
+    });
+
+    Bench::Measure("SetMatrix4 by name", SetsPerCall, [&]()
+    {
+        for (uint32_t i = 0; i < SetsPerCall; i++)
+            shader.SetMatrix4("u_Model", glm::mat4(next()));
+        recorder.Reset();
+    });
+    Bench::Measure("SetMatrix4 by handle", SetsPerCall, [&]()
+    {
+        for (uint32_t i = 0; i < SetsPerCall; i++)
+            shader.SetMatrix4(model, glm::mat4(next()));
+        recorder.Reset();
+    });
+
+    // The lookup alone, what a name costs on top of a handle
+    Bench::Measure("GetUniformHandle", SetsPerCall, [&]()
+    {
+        uint64_t sum = 0;
+        for (uint32_t i = 0; i < SetsPerCall; i++)
+            sum += static_cast<uint64_t>(shader.GetUniformHandle(i % 2 ? "u_Time" : "u_Color").Index);
+        Bench::Consume(sum);
+    });
+}
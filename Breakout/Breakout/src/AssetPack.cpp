@@ -0,0 +1,161 @@
+#include "AssetPack.h"
+
+#include <iostream>
+
+#ifdef _WIN32
+    #define WIN32_LEAN_AND_MEAN
+    #define NOMINMAX
+    #include <Windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+using namespace AssetPackFormat;
+
+namespace
+{
+    // [offset, offset + size) lies within the file, written so that neither sum can wrap around
+    bool IsInFile(const uint64_t offset, const uint64_t size, const uint64_t fileSize)
+    {
+        return offset <= fileSize && size <= fileSize - offset;
+    }
+
+    // Why the entry cannot be handed to its loader as is, nullptr when it can
+    const char* ValidateEntry(const PackEntry& entry, const unsigned char* data)
+    {
+        switch (entry.Type)
+        {
+            case EntryType::Texture:
+            {
+                if (entry.Width <= 0 || entry.Height <= 0 || entry.Channels < 1 || entry.Channels > 4)
+                    return "invalid texture dimensions";
+                // Divided rather than multiplied, width * height * channels may not fit in 64 bits
+                const uint64_t texels = static_cast<uint64_t>(entry.Width) * static_cast<uint64_t>(entry.Height);
+                if (texels > entry.DataSize / static_cast<uint64_t>(entry.Channels))
+                    return "texture data smaller than its dimensions";
+                return nullptr;
+            }
+            case EntryType::Shader:
+                if (entry.DataSize == 0 || data[entry.DataOffset + entry.DataSize - 1] != '\0')
+                    return "shader source not null-terminated";
+                return nullptr;
+            default:
+                return nullptr;
+        }
+    }
+}
+
+AssetPack::~AssetPack()
+{
+    Close();
+}
+
+bool AssetPack::Open(const char* filePath)
+{
+    Close();
+
+#ifdef _WIN32
+    m_File = CreateFileA(filePath, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (m_File == INVALID_HANDLE_VALUE)
+    {
+        m_File = nullptr;
+        return false;
+    }
+
+    LARGE_INTEGER size;
+    GetFileSizeEx(m_File, &size);
+    m_Size = static_cast<uint64_t>(size.QuadPart);
+
+    m_Mapping = CreateFileMappingA(m_File, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (m_Mapping != nullptr)
+        m_Data = static_cast<const unsigned char*>(MapViewOfFile(m_Mapping, FILE_MAP_READ, 0, 0, 0));
+#else
+    const int file = open(filePath, O_RDONLY);
+    if (file < 0)
+        return false;
+
+    struct stat status{};
+    if (fstat(file, &status) == 0 && status.st_size > 0)
+    {
+        m_Size = static_cast<uint64_t>(status.st_size);
+        void* mapping = mmap(nullptr, m_Size, PROT_READ, MAP_PRIVATE, file, 0);
+        if (mapping != MAP_FAILED)
+            m_Data = static_cast<const unsigned char*>(mapping);
+    }
+    // The mapping stays valid once the descriptor is closed
+    close(file);
+#endif
+
+    if (m_Data == nullptr)
+    {
+        std::cout << "[ERROR] AssetPack: Failed to map '" << filePath << "'" << '\n';
+        Close();
+        return false;
+    }
+
+    const auto* header = reinterpret_cast<const PackHeader*>(m_Data);
+    if (m_Size < sizeof(PackHeader) || header->Magic != Magic || header->Version != Version || header->TocOffset % alignof(PackEntry) != 0
+        || !IsInFile(header->TocOffset, static_cast<uint64_t>(header->EntryCount) * sizeof(PackEntry), m_Size) || header->NamesOffset > m_Size)
+    {
+        std::cout << "[ERROR] AssetPack: '" << filePath << "' is not a valid asset pack (version " << Version << ")" << '\n';
+        Close();
+        return false;
+    }
+
+    const auto* entries = reinterpret_cast<const PackEntry*>(m_Data + header->TocOffset);
+    const auto* names = reinterpret_cast<const char*>(m_Data + header->NamesOffset);
+    m_Entries.reserve(header->EntryCount);
+    for (uint32_t i = 0; i < header->EntryCount; i++)
+    {
+        const PackEntry& entry = entries[i];
+        if (!IsInFile(entry.DataOffset, entry.DataSize, m_Size) || !IsInFile(header->NamesOffset + entry.NameOffset, entry.NameLength, m_Size))
+        {
+            std::cout << "[ERROR] AssetPack: '" << filePath << "' is truncated" << '\n';
+            Close();
+            return false;
+        }
+
+        const std::string_view name(names + entry.NameOffset, entry.NameLength);
+        if (const char* error = ValidateEntry(entry, m_Data))
+        {
+            std::cout << "[ERROR] AssetPack: '" << filePath << "' is corrupted, entry '" << name << "': " << error << '\n';
+            Close();
+            return false;
+        }
+
+        m_Entries.emplace(name, &entry);
+    }
+
+    return true;
+}
+
+void AssetPack::Close()
+{
+    m_Entries.clear();
+
+#ifdef _WIN32
+    if (m_Data != nullptr)
+        UnmapViewOfFile(m_Data);
+    if (m_Mapping != nullptr)
+        CloseHandle(m_Mapping);
+    if (m_File != nullptr)
+        CloseHandle(m_File);
+    m_Mapping = nullptr;
+    m_File = nullptr;
+#else
+    if (m_Data != nullptr)
+        munmap(const_cast<unsigned char*>(m_Data), m_Size);
+#endif
+
+    m_Data = nullptr;
+    m_Size = 0;
+}
+
+const PackEntry* AssetPack::Find(const std::string_view name) const
+{
+    const auto it = m_Entries.find(name);
+    return it != m_Entries.end() ? it->second : nullptr;
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include "AssetPackFormat.h"
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+// Read-only, memory-mapped asset pack produced by the AssetPacker tool.
+// Entry data points straight into the mapping: nothing is copied until it reaches GL.
+class AssetPack
+{
+public:
+    AssetPack() = default;
+    AssetPack(const AssetPack& other) = delete;
+    ~AssetPack();
+
+    bool Open(const char* filePath);
+    void Close();
+    bool IsOpen() const { return m_Data != nullptr; }
+
+    // Entries are looked up by the path they were packed under, with forward slashes
+    const AssetPackFormat::PackEntry* Find(std::string_view name) const;
+    const unsigned char* GetData(const AssetPackFormat::PackEntry& entry) const { return m_Data + entry.DataOffset; }
+    uint32_t GetEntryCount() const { return static_cast<uint32_t>(m_Entries.size()); }
+private:
+    const unsigned char* m_Data = nullptr;
+    uint64_t m_Size = 0;
+#ifdef _WIN32
+    void* m_File = nullptr;
+    void* m_Mapping = nullptr;
+#endif
+
+    std::unordered_map<std::string_view, const AssetPackFormat::PackEntry*> m_Entries;
+};
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstdint>
+
+// Binary layout of an asset pack, shared by the game and the offline AssetPacker tool.
+//
+//   PackHeader
+//   PackEntry[EntryCount]          table of contents
+//   char[]                          entry names (not null-terminated)
+//   blobs, each aligned on BlobAlignment
+//
+// Shader blobs hold the source followed by a null terminator so they can be handed to glShaderSource as is.
+// Texture blobs hold decoded texels, already flipped vertically like stb_image does at runtime.
+namespace AssetPackFormat
+{
+    constexpr uint32_t Magic = 0x4b415042; // "BPAK"
+    constexpr uint32_t Version = 1;
+    constexpr uint64_t BlobAlignment = 64;
+
+    enum class EntryType : uint32_t
+    {
+        Raw = 0,
+        Shader = 1,
+        Texture = 2
+    };
+
+    struct PackHeader
+    {
+        uint32_t Magic;
+        uint32_t Version;
+        uint32_t EntryCount;
+        uint32_t Reserved;
+        uint64_t TocOffset;
+        uint64_t NamesOffset;
+    };
+
+    struct PackEntry
+    {
+        uint64_t DataOffset;
+        uint64_t DataSize;
+        uint32_t NameOffset; // relative to PackHeader::NamesOffset
+        uint32_t NameLength;
+        EntryType Type;
+        int32_t Width;       // textures only
+        int32_t Height;
+        int32_t Channels;
+    };
+
+    static_assert(sizeof(PackHeader) == 32, "PackHeader layout must not depend on the compiler");
+    static_assert(sizeof(PackEntry) == 40, "PackEntry layout must not depend on the compiler");
+}
@@ -0,0 +1,79 @@
+#include "AllocationCounter.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+    std::atomic<uint64_t> s_Count{ 0 };
+    std::atomic<uint64_t> s_Bytes{ 0 };
+}
+
+uint64_t AllocationCounter::GetCount()
+{
+    return s_Count.load(std::memory_order_relaxed);
+}
+
+uint64_t AllocationCounter::GetBytes()
+{
+    return s_Bytes.load(std::memory_order_relaxed);
+}
+
+#if BREAKOUT_COUNT_ALLOCATIONS
+
+namespace
+{
+    void* CountedAllocate(size_t size, const size_t alignment)
+    {
+        s_Count.fetch_add(1, std::memory_order_relaxed);
+        s_Bytes.fetch_add(size, std::memory_order_relaxed);
+
+        if (size == 0)
+            size = 1;
+#ifdef _MSC_VER
+        return _aligned_malloc(size, alignment);
+#else
+        // aligned_alloc wants a multiple of the alignment
+        return std::aligned_alloc(alignment, (size + alignment - 1) & ~(alignment - 1));
+#endif
+    }
+
+    void CountedFree(void* block)
+    {
+#ifdef _MSC_VER
+        _aligned_free(block);
+#else
+        std::free(block);
+#endif
+    }
+
+    void* CountedAllocateOrThrow(const size_t size, const size_t alignment)
+    {
+        void* block = CountedAllocate(size, alignment);
+        if (block == nullptr)
+            throw std::bad_alloc();
+        return block;
+    }
+}
+
+// Every form goes through the aligned allocation so that any block can be released by any form of delete
+void* operator new(const size_t size) { return CountedAllocateOrThrow(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__); }
+void* operator new[](const size_t size) { return CountedAllocateOrThrow(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__); }
+void* operator new(const size_t size, const std::align_val_t alignment) { return CountedAllocateOrThrow(size, static_cast<size_t>(alignment)); }
+void* operator new[](const size_t size, const std::align_val_t alignment) { return CountedAllocateOrThrow(size, static_cast<size_t>(alignment)); }
+void* operator new(const size_t size, const std::nothrow_t&) noexcept { return CountedAllocate(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__); }
+void* operator new[](const size_t size, const std::nothrow_t&) noexcept { return CountedAllocate(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__); }
+
+void operator delete(void* block) noexcept { CountedFree(block); }
+void operator delete[](void* block) noexcept { CountedFree(block); }
+void operator delete(void* block, size_t) noexcept { CountedFree(block); }
+void operator delete[](void* block, size_t) noexcept { CountedFree(block); }
+void operator delete(void* block, std::align_val_t) noexcept { CountedFree(block); }
+void operator delete[](void* block, std::align_val_t) noexcept { CountedFree(block); }
+void operator delete(void* block, size_t, std::align_val_t) noexcept { CountedFree(block); }
+void operator delete[](void* block, size_t, std::align_val_t) noexcept { CountedFree(block); }
+void operator delete(void* block, const std::nothrow_t&) noexcept { CountedFree(block); }
+void operator delete[](void* block, const std::nothrow_t&) noexcept { CountedFree(block); }
+
+#endif
@@ -0,0 +1,19 @@
+#pragma once
+
+#include <cstdint>
+
+// Heap allocation counting is compiled out unless BREAKOUT_COUNT_ALLOCATIONS is defined to 1, in which case the
+// global operator new/delete are replaced by counting versions
+#ifndef BREAKOUT_COUNT_ALLOCATIONS
+    #define BREAKOUT_COUNT_ALLOCATIONS 0
+#endif
+
+// Process-wide totals since startup, every thread included. Both stay at 0 when counting is compiled out.
+class AllocationCounter
+{
+public:
+    static constexpr bool Enabled = BREAKOUT_COUNT_ALLOCATIONS != 0;
+
+    static uint64_t GetCount();
+    static uint64_t GetBytes();
+};
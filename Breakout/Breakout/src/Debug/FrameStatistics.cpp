@@ -0,0 +1,171 @@
+#include "FrameStatistics.h"
+
+#include "Profiler.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+namespace
+{
+    constexpr size_t HitchZoneCount = 4;
+
+    void WriteRow(std::ostream& stream, const char* label, const DurationHistogram& histogram)
+    {
+        stream << std::left << std::setw(8) << label << std::right << std::setw(10) << histogram.GetCount()
+            << std::setw(10) << histogram.GetMean() << std::setw(10) << histogram.GetPercentile(50.0)
+            << std::setw(10) << histogram.GetPercentile(95.0) << std::setw(10) << histogram.GetPercentile(99.0)
+            << std::setw(10) << histogram.GetMax() << '\n';
+    }
+}
+
+void DurationHistogram::Record(const uint64_t microseconds)
+{
+    m_Counts[GetBucket(microseconds)]++;
+    m_Count++;
+    m_Total += microseconds;
+    m_Max = std::max(m_Max, microseconds);
+}
+
+void DurationHistogram::Reset()
+{
+    *this = DurationHistogram();
+}
+
+double DurationHistogram::GetPercentile(const double percentile) const
+{
+    if (m_Count == 0)
+        return 0.0;
+
+    const auto rank = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(percentile / 100.0 * static_cast<double>(m_Count))));
+    uint64_t seen = 0;
+    for (uint32_t bucket = 0; bucket < BucketCount; bucket++)
+    {
+        seen += m_Counts[bucket];
+        if (seen >= rank)
+            return static_cast<double>(std::min(GetBucketLimit(bucket), m_Max)) / 1000.0;
+    }
+
+    return GetMax();
+}
+
+double DurationHistogram::GetMean() const
+{
+    return m_Count > 0 ? static_cast<double>(m_Total) / static_cast<double>(m_Count) / 1000.0 : 0.0;
+}
+
+double DurationHistogram::GetMax() const
+{
+    return static_cast<double>(m_Max) / 1000.0;
+}
+
+uint32_t DurationHistogram::GetBucket(uint64_t microseconds)
+{
+    constexpr uint64_t linearLimit = 2u << SubBucketBits;
+    if (microseconds < linearLimit)
+        return static_cast<uint32_t>(microseconds);
+
+    // Values beyond the range land in the last bucket
+    microseconds = std::min(microseconds, GetBucketLimit(BucketCount - 1));
+
+    // Shift the value down until it has SubBucketBits + 1 significant bits: [64, 128)
+    uint32_t shift = 0;
+    while ((microseconds >> shift) >= linearLimit)
+        shift++;
+
+    return (shift << SubBucketBits) + static_cast<uint32_t>(microseconds >> shift);
+}
+
+uint64_t DurationHistogram::GetBucketLimit(const uint32_t bucket)
+{
+    if (bucket < (2u << SubBucketBits))
+        return bucket;
+
+    const uint32_t shift = (bucket >> SubBucketBits) - 1;
+    const uint64_t subBucket = bucket - (shift << SubBucketBits);
+    return ((subBucket + 1) << shift) - 1;
+}
+
+void FrameStatistics::RecordFrame(const uint64_t start, const uint64_t end)
+{
+    const uint64_t microseconds = (end - start) / 1000;
+    m_FrameTimes.Record(microseconds);
+    m_RecentFrameTimes.Record(microseconds);
+
+    if (static_cast<double>(microseconds) / 1000.0 > m_HitchThreshold)
+        ReportHitch(start, end);
+}
+
+void FrameStatistics::RecordTick(const uint64_t start, const uint64_t end)
+{
+    m_TickTimes.Record((end - start) / 1000);
+}
+
+void FrameStatistics::WriteSummary(std::ostream& stream) const
+{
+    const std::ios::fmtflags flags = stream.flags();
+    const std::streamsize precision = stream.precision();
+    stream << std::fixed << std::setprecision(2);
+
+    stream << "Frame statistics (ms)" << '\n';
+    stream << std::left << std::setw(8) << "" << std::right << std::setw(10) << "count" << std::setw(10) << "mean"
+        << std::setw(10) << "p50" << std::setw(10) << "p95" << std::setw(10) << "p99" << std::setw(10) << "max" << '\n';
+    WriteRow(stream, "frame", m_FrameTimes);
+    WriteRow(stream, "tick", m_TickTimes);
+
+    stream << "Hitches over " << m_HitchThreshold << " ms: " << m_HitchCount << '\n';
+    for (const Hitch& hitch : m_Hitches)
+        stream << "  frame " << hitch.Frame << ": " << hitch.Milliseconds << " ms (" << hitch.Zones << ")" << '\n';
+    if (m_HitchCount > m_Hitches.size())
+        stream << "  ... " << m_HitchCount - m_Hitches.size() << " more" << '\n';
+
+    stream.flags(flags);
+    stream.precision(precision);
+}
+
+void FrameStatistics::ReportHitch(const uint64_t start, const uint64_t end)
+{
+    m_HitchCount++;
+    if (m_Hitches.size() >= MaxHitches)
+        return;
+
+    // Time spent in each zone name within the frame, zones enclosing the whole frame excluded
+    struct ZoneTotal
+    {
+        const char* Name;
+        uint64_t Nanoseconds;
+    };
+
+    std::vector<Profiler::Zone> zones;
+    Profiler::GetZones(start, end, zones);
+
+    std::vector<ZoneTotal> totals;
+    for (const Profiler::Zone& zone : zones)
+    {
+        const uint64_t overlap = std::min(zone.End, end) - std::max(zone.Start, start);
+        if (overlap == end - start)
+            continue;
+
+        const auto total = std::find_if(totals.begin(), totals.end(),
+            [&zone](const ZoneTotal& other) { return std::strcmp(other.Name, zone.Name) == 0; });
+        if (total != totals.end())
+            total->Nanoseconds += overlap;
+        else
+            totals.push_back({ zone.Name, overlap });
+    }
+
+    std::sort(totals.begin(), totals.end(), [](const ZoneTotal& a, const ZoneTotal& b) { return a.Nanoseconds > b.Nanoseconds; });
+
+    std::ostringstream description;
+    description << std::fixed << std::setprecision(2);
+    for (size_t i = 0; i < std::min(totals.size(), HitchZoneCount); i++)
+        description << (i > 0 ? ", " : "") << totals[i].Name << " " << static_cast<double>(totals[i].Nanoseconds) / 1000000.0 << " ms";
+    if (totals.empty())
+        description << "no zones recorded";
+
+    const Hitch& hitch = m_Hitches.emplace_back(Hitch{ m_FrameTimes.GetCount(), static_cast<double>(end - start) / 1000000.0, description.str() });
+    std::cout << "| [WARNING] FrameStatistics: Hitch on frame " << hitch.Frame << ": " << hitch.Milliseconds << " ms (" << hitch.Zones << ")" << '\n';
+}
@@ -0,0 +1,145 @@
+#include "GoldenImage.h"
+
+#include <stb_image/stb_image.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+
+namespace
+{
+    uint32_t Crc32(const unsigned char* data, const size_t size, uint32_t crc = 0)
+    {
+        static uint32_t table[256] = {};
+        if (table[1] == 0)
+        {
+            for (uint32_t i = 0; i < 256; i++)
+            {
+                uint32_t value = i;
+                for (int bit = 0; bit < 8; bit++)
+                    value = (value & 1) ? 0xedb88320u ^ (value >> 1) : value >> 1;
+                table[i] = value;
+            }
+        }
+
+        crc = ~crc;
+        for (size_t i = 0; i < size; i++)
+            crc = table[(crc ^ data[i]) & 0xff] ^ (crc >> 8);
+        return ~crc;
+    }
+
+    void AppendBigEndian(std::vector<unsigned char>& buffer, const uint32_t value)
+    {
+        buffer.push_back(static_cast<unsigned char>(value >> 24));
+        buffer.push_back(static_cast<unsigned char>(value >> 16));
+        buffer.push_back(static_cast<unsigned char>(value >> 8));
+        buffer.push_back(static_cast<unsigned char>(value));
+    }
+
+    void AppendChunk(std::vector<unsigned char>& png, const char* type, const std::vector<unsigned char>& data)
+    {
+        AppendBigEndian(png, static_cast<uint32_t>(data.size()));
+        const size_t typeOffset = png.size();
+        png.insert(png.end(), type, type + 4);
+        png.insert(png.end(), data.begin(), data.end());
+        AppendBigEndian(png, Crc32(&png[typeOffset], png.size() - typeOffset));
+    }
+}
+
+GoldenImage::GoldenImage(const int width, const int height, std::vector<unsigned char> pixels)
+    : m_Width(width), m_Height(height), m_Pixels(std::move(pixels))
+{
+}
+
+bool GoldenImage::Load(const std::string& filePath)
+{
+    // Captures are stored top row first, unlike textures. Once set, the per-thread flag overrides the global one for
+    // good, so it is put back to the flip every texture load of the game expects.
+    stbi_set_flip_vertically_on_load_thread(0);
+
+    int width, height, channels;
+    unsigned char* pixels = stbi_load(filePath.c_str(), &width, &height, &channels, 4);
+    stbi_set_flip_vertically_on_load_thread(1);
+    if (pixels == nullptr)
+        return false;
+
+    m_Width = width;
+    m_Height = height;
+    m_Pixels.assign(pixels, pixels + static_cast<size_t>(width) * height * 4);
+    stbi_image_free(pixels);
+    return true;
+}
+
+bool GoldenImage::Save(const std::string& filePath) const
+{
+    static constexpr unsigned char signature[] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1a, '\n' };
+    std::vector<unsigned char> png(std::begin(signature), std::end(signature));
+
+    std::vector<unsigned char> header;
+    AppendBigEndian(header, static_cast<uint32_t>(m_Width));
+    AppendBigEndian(header, static_cast<uint32_t>(m_Height));
+    header.insert(header.end(), { 8, 6, 0, 0, 0 }); // 8 bits per channel, RGBA, no interlacing
+    AppendChunk(png, "IHDR", header);
+
+    // Scanlines prefixed with filter type 0, wrapped in a zlib stream made of stored (uncompressed) deflate blocks
+    const size_t rowSize = static_cast<size_t>(m_Width) * 4;
+    std::vector<unsigned char> raw;
+    raw.reserve((rowSize + 1) * m_Height);
+    for (int y = 0; y < m_Height; y++)
+    {
+        raw.push_back(0);
+        raw.insert(raw.end(), m_Pixels.begin() + y * rowSize, m_Pixels.begin() + (y + 1) * rowSize);
+    }
+
+    std::vector<unsigned char> zlib = { 0x78, 0x01 };
+    size_t offset = 0;
+    do
+    {
+        const size_t blockSize = std::min<size_t>(raw.size() - offset, 65535);
+        zlib.push_back(offset + blockSize == raw.size() ? 1 : 0);
+        zlib.push_back(static_cast<unsigned char>(blockSize));
+        zlib.push_back(static_cast<unsigned char>(blockSize >> 8));
+        zlib.push_back(static_cast<unsigned char>(~blockSize));
+        zlib.push_back(static_cast<unsigned char>(~blockSize >> 8));
+        zlib.insert(zlib.end(), raw.begin() + offset, raw.begin() + offset + blockSize);
+        offset += blockSize;
+    } while (offset < raw.size());
+
+    uint32_t a = 1, b = 0;
+    for (const unsigned char byte : raw)
+    {
+        a = (a + byte) % 65521;
+        b = (b + a) % 65521;
+    }
+    AppendBigEndian(zlib, (b << 16) | a);
+
+    AppendChunk(png, "IDAT", zlib);
+    AppendChunk(png, "IEND", {});
+
+    std::ofstream file(filePath, std::ios::binary | std::ios::trunc);
+    file.write(reinterpret_cast<const char*>(png.data()), static_cast<std::streamsize>(png.size()));
+    return static_cast<bool>(file);
+}
+
+GoldenImage::Comparison GoldenImage::Compare(const GoldenImage& expected, const int tolerance) const
+{
+    Comparison comparison;
+    if (m_Width != expected.m_Width || m_Height != expected.m_Height)
+    {
+        comparison.SizeMismatch = true;
+        return comparison;
+    }
+
+    for (size_t i = 0; i < m_Pixels.size(); i += 4)
+    {
+        int pixelDifference = 0;
+        for (size_t channel = 0; channel < 4; channel++)
+            pixelDifference = std::max(pixelDifference, std::abs(m_Pixels[i + channel] - expected.m_Pixels[i + channel]));
+
+        comparison.MaxDifference = std::max(comparison.MaxDifference, pixelDifference);
+        if (pixelDifference > tolerance)
+            comparison.MismatchedPixels++;
+    }
+
+    return comparison;
+}
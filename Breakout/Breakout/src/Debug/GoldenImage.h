@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// RGBA8 image (top row first) compared against reference captures stored as PNG.
+// Used by the golden-image run to catch rendering regressions on software GL.
+class GoldenImage
+{
+public:
+    struct Comparison
+    {
+        uint32_t MismatchedPixels = 0; // pixels with a channel differing by more than the tolerance
+        int MaxDifference = 0;         // largest channel difference over the whole image
+        bool SizeMismatch = false;
+
+        bool Passed(const uint32_t maxMismatchedPixels) const { return !SizeMismatch && MismatchedPixels <= maxMismatchedPixels; }
+    };
+
+    GoldenImage() = default;
+    GoldenImage(int width, int height, std::vector<unsigned char> pixels);
+
+    bool Load(const std::string& filePath);
+    // Written uncompressed: bigger files, but no dependency beyond what stb_image can read back
+    bool Save(const std::string& filePath) const;
+
+    Comparison Compare(const GoldenImage& expected, int tolerance) const;
+
+    int GetWidth() const { return m_Width; }
+    int GetHeight() const { return m_Height; }
+    const std::vector<unsigned char>& GetPixels() const { return m_Pixels; }
+private:
+    int m_Width = 0, m_Height = 0;
+    std::vector<unsigned char> m_Pixels;
+};
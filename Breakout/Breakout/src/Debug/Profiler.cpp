@@ -0,0 +1,226 @@
+#include "Profiler.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace
+{
+    static_assert((Profiler::ZonesPerThread & (Profiler::ZonesPerThread - 1)) == 0, "ZonesPerThread must be a power of two");
+
+    constexpr uint64_t CalibrationNanoseconds = 10000000;
+
+    // Ticks and steady clock read at the same moment, and the tick period measured from there
+    struct Calibration
+    {
+        uint64_t Ticks;
+        uint64_t Nanoseconds;
+        double NanosecondsPerTick;
+    };
+
+    const Calibration& GetCalibration()
+    {
+        static const Calibration calibration = []
+        {
+            const uint64_t startTicks = Profiler::Ticks();
+            const uint64_t start = Profiler::SteadyClockNanoseconds();
+            uint64_t end = start;
+            while (end - start < CalibrationNanoseconds)
+                end = Profiler::SteadyClockNanoseconds();
+            const uint64_t endTicks = Profiler::Ticks();
+
+            return Calibration{ startTicks, start, static_cast<double>(end - start) / static_cast<double>(endTicks - startTicks) };
+        }();
+        return calibration;
+    }
+
+    struct ThreadBuffer
+    {
+        std::unique_ptr<Profiler::Zone[]> Zones = std::make_unique<Profiler::Zone[]>(Profiler::ZonesPerThread);
+        // Total zones ever recorded, only written by the owning thread
+        std::atomic<uint64_t> Count{ 0 };
+        uint32_t ThreadIndex = 0;
+        std::string Name;
+        bool Gpu = false; // zones already in nanoseconds
+    };
+
+    // Buffers outlive their thread so that zones of finished threads still make it into the trace
+    struct Registry
+    {
+        std::mutex Mutex;
+        std::vector<std::unique_ptr<ThreadBuffer>> Buffers;
+    };
+
+    Registry& GetRegistry()
+    {
+        static Registry registry;
+        return registry;
+    }
+
+    thread_local ThreadBuffer* t_Buffer = nullptr;
+
+    ThreadBuffer* CreateBuffer(const std::string& name)
+    {
+        Registry& registry = GetRegistry();
+        std::lock_guard<std::mutex> lock(registry.Mutex);
+
+        auto buffer = std::make_unique<ThreadBuffer>();
+        buffer->ThreadIndex = static_cast<uint32_t>(registry.Buffers.size());
+        buffer->Name = name.empty() ? "Thread " + std::to_string(buffer->ThreadIndex) : name;
+        registry.Buffers.push_back(std::move(buffer));
+        return registry.Buffers.back().get();
+    }
+
+    ThreadBuffer& GetThreadBuffer()
+    {
+        if (t_Buffer == nullptr)
+            t_Buffer = CreateBuffer({});
+
+        return *t_Buffer;
+    }
+
+    void Append(ThreadBuffer& buffer, const char* name, const uint64_t start, const uint64_t end)
+    {
+        const uint64_t index = buffer.Count.load(std::memory_order_relaxed);
+        buffer.Zones[index & (Profiler::ZonesPerThread - 1)] = { name, start, end };
+        buffer.Count.store(index + 1, std::memory_order_release);
+    }
+
+    Profiler::Zone ToNanoseconds(const ThreadBuffer& buffer, const Profiler::Zone& zone)
+    {
+        if (buffer.Gpu)
+            return zone;
+        return { zone.Name, Profiler::TicksToNanoseconds(zone.Start), Profiler::TicksToNanoseconds(zone.End) };
+    }
+
+    void WriteEscaped(std::ostream& stream, const char* text)
+    {
+        for (; *text != '\0'; ++text)
+        {
+            if (*text == '"' || *text == '\\')
+                stream << '\\';
+            stream << *text;
+        }
+    }
+}
+
+uint64_t Profiler::Now()
+{
+    return TicksToNanoseconds(Ticks());
+}
+
+uint64_t Profiler::TicksToNanoseconds(const uint64_t ticks)
+{
+    // Zones may predate the calibration
+    const Calibration& calibration = GetCalibration();
+    const double elapsed = static_cast<double>(static_cast<int64_t>(ticks - calibration.Ticks)) * calibration.NanosecondsPerTick;
+    return calibration.Nanoseconds + static_cast<uint64_t>(static_cast<int64_t>(elapsed));
+}
+
+uint64_t Profiler::SteadyClockNanoseconds()
+{
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+void Profiler::Record(const char* name, const uint64_t start, const uint64_t end)
+{
+    Append(GetThreadBuffer(), name, start, end);
+}
+
+void Profiler::RecordGpu(const char* name, const uint64_t start, const uint64_t end)
+{
+    static ThreadBuffer* gpuBuffer = []
+    {
+        ThreadBuffer* buffer = CreateBuffer("GPU");
+        buffer->Gpu = true;
+        return buffer;
+    }();
+    Append(*gpuBuffer, name, start, end);
+}
+
+void Profiler::SetThreadName(const std::string& name)
+{
+    ThreadBuffer& buffer = GetThreadBuffer();
+    std::lock_guard<std::mutex> lock(GetRegistry().Mutex);
+    buffer.Name = name;
+}
+
+void Profiler::GetZones(const uint64_t start, const uint64_t end, std::vector<Zone>& outZones)
+{
+    Registry& registry = GetRegistry();
+    std::lock_guard<std::mutex> lock(registry.Mutex);
+
+    for (const auto& buffer : registry.Buffers)
+    {
+        if (buffer->Gpu)
+            continue;
+
+        // Zones are stored in the order they close: walking back from the newest, the first one that
+        // ended before start means every older one did too
+        const uint64_t count = buffer->Count.load(std::memory_order_acquire);
+        const uint64_t oldest = count > ZonesPerThread ? count - ZonesPerThread : 0;
+        for (uint64_t i = count; i > oldest; i--)
+        {
+            const Zone zone = ToNanoseconds(*buffer, buffer->Zones[(i - 1) & (ZonesPerThread - 1)]);
+            if (zone.End < start)
+                break;
+            if (zone.Start <= end)
+                outZones.push_back(zone);
+        }
+    }
+}
+
+bool Profiler::WriteTrace(const std::string& filePath)
+{
+    std::ofstream file(filePath, std::ios::trunc);
+    if (!file)
+    {
+        std::cout << "[ERROR] Profiler: Failed to create '" << filePath << "'" << '\n';
+        return false;
+    }
+
+    Registry& registry = GetRegistry();
+    std::lock_guard<std::mutex> lock(registry.Mutex);
+
+    // Timestamps are made relative to the oldest zone still in the buffers
+    uint64_t origin = UINT64_MAX;
+    for (const auto& buffer : registry.Buffers)
+    {
+        const uint64_t count = buffer->Count.load(std::memory_order_acquire);
+        for (uint64_t i = count > ZonesPerThread ? count - ZonesPerThread : 0; i < count; i++)
+            origin = std::min(origin, ToNanoseconds(*buffer, buffer->Zones[i & (ZonesPerThread - 1)]).Start);
+    }
+
+    size_t zoneCount = 0;
+    file << std::fixed << std::setprecision(3) << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    const char* separator = "\n";
+    for (const auto& buffer : registry.Buffers)
+    {
+        file << separator << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->ThreadIndex << ",\"args\":{\"name\":\"";
+        WriteEscaped(file, buffer->Name.c_str());
+        file << "\"}}";
+        separator = ",\n";
+
+        const uint64_t count = buffer->Count.load(std::memory_order_acquire);
+        for (uint64_t i = count > ZonesPerThread ? count - ZonesPerThread : 0; i < count; i++)
+        {
+            const Zone zone = ToNanoseconds(*buffer, buffer->Zones[i & (ZonesPerThread - 1)]);
+            file << separator << "{\"name\":\"";
+            WriteEscaped(file, zone.Name);
+            file << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer->ThreadIndex
+                << ",\"ts\":" << static_cast<double>(zone.Start - origin) / 1000.0
+                << ",\"dur\":" << static_cast<double>(zone.End - zone.Start) / 1000.0 << "}";
+            zoneCount++;
+        }
+    }
+    file << "\n]}\n";
+
+    std::cout << "| [INFO] Profiler: Wrote " << zoneCount << " zones from " << registry.Buffers.size() << " threads to '" << filePath << "'" << '\n';
+    return static_cast<bool>(file);
+}
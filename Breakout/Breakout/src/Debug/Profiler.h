@@ -0,0 +1,98 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#if defined(_MSC_VER)
+    #include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+    #include <x86intrin.h>
+#endif
+
+// Zones are compiled in unless BREAKOUT_PROFILE is defined to 0, in which case the macros expand to nothing
+#ifndef BREAKOUT_PROFILE
+    #define BREAKOUT_PROFILE 1
+#endif
+
+// In-process CPU profiler. Every thread records the zones it closes into its own ring buffer (no lock, no
+// allocation once the buffer exists); the most recent zones of every thread can be exported as a Chrome trace
+// (chrome://tracing, ui.perfetto.dev). Zones are timed with the raw timestamp counter and only converted to
+// nanoseconds when they are read back.
+class Profiler
+{
+public:
+    // Zones kept per thread, older ones are overwritten
+    static constexpr uint32_t ZonesPerThread = 1u << 16;
+
+    struct Zone
+    {
+        const char* Name; // must outlive the profiler, string literals only
+        uint64_t Start;   // ticks while recorded, nanoseconds (see Now) once read back
+        uint64_t End;
+    };
+
+    // Timestamp counter, a few nanoseconds to read against tens for the steady clock. Its rate is constant on
+    // x86 CPUs with an invariant TSC; elsewhere it is the steady clock in nanoseconds.
+    static uint64_t Ticks()
+    {
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+        return __rdtsc();
+#else
+        return SteadyClockNanoseconds();
+#endif
+    }
+    // Nanoseconds on the same timeline as the converted zones. The tick rate is measured against the steady
+    // clock the first time a conversion is needed, which takes a few milliseconds.
+    static uint64_t Now();
+    static uint64_t TicksToNanoseconds(uint64_t ticks);
+
+    // start and end in ticks
+    static void Record(const char* name, uint64_t start, uint64_t end);
+    // Zones timed on the GPU go to a track of their own, only the render thread may record them.
+    // start and end in nanoseconds.
+    static void RecordGpu(const char* name, uint64_t start, uint64_t end);
+
+    // Shown as the thread's track name in the trace
+    static void SetThreadName(const std::string& name);
+
+    // Zones of every thread (GPU track excluded) overlapping [start, end], appended to outZones.
+    // Same caveat as WriteTrace for zones recorded while it runs.
+    static void GetZones(uint64_t start, uint64_t end, std::vector<Zone>& outZones);
+
+    // Not synchronized with the recording threads: zones written while the export runs may come out torn,
+    // export once the threads are idle (between frames, at exit)
+    static bool WriteTrace(const std::string& filePath);
+
+    // Reference the tick rate is measured against
+    static uint64_t SteadyClockNanoseconds();
+};
+
+class ProfileScope
+{
+public:
+    explicit ProfileScope(const char* name)
+        : m_Name(name), m_Start(Profiler::Ticks())
+    {
+    }
+
+    ProfileScope(const ProfileScope& other) = delete;
+
+    ~ProfileScope()
+    {
+        Profiler::Record(m_Name, m_Start, Profiler::Ticks());
+    }
+private:
+    const char* m_Name;
+    uint64_t m_Start;
+};
+
+#if BREAKOUT_PROFILE
+    #define PROFILE_CONCATENATE_IMPL(a, b) a##b
+    #define PROFILE_CONCATENATE(a, b) PROFILE_CONCATENATE_IMPL(a, b)
+    #define PROFILE_SCOPE(name) const ProfileScope PROFILE_CONCATENATE(profileScope, __COUNTER__)(name)
+    #define PROFILE_FUNCTION() PROFILE_SCOPE(__FUNCTION__)
+#else
+    #define PROFILE_SCOPE(name)
+    #define PROFILE_FUNCTION()
+#endif
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// Entity handle: slot index in the low bits, version of the slot in the high bits. Destroying an entity bumps the
+// version of its slot, so handles kept around after the entity is gone no longer match when the slot is reused.
+using Entity = uint32_t;
+
+constexpr uint32_t EntityIndexBits = 20;
+constexpr uint32_t EntityIndexMask = (1u << EntityIndexBits) - 1;
+constexpr uint32_t EntityVersionMask = ~EntityIndexMask;
+constexpr Entity NullEntity = UINT32_MAX;
+
+inline uint32_t GetEntityIndex(const Entity entity) { return entity & EntityIndexMask; }
+inline uint32_t GetEntityVersion(const Entity entity) { return entity >> EntityIndexBits; }
+
+class ComponentPoolBase
+{
+public:
+    virtual ~ComponentPoolBase() = default;
+
+    bool Contains(const Entity entity) const
+    {
+        const uint32_t index = GetEntityIndex(entity);
+        return index < m_Sparse.size() && m_Sparse[index] != InvalidSlot && m_Entities[m_Sparse[index]] == entity;
+    }
+
+    // Type-erased removal, used when an entity is destroyed with all its components
+    virtual void Remove(Entity entity) = 0;
+
+    // Owners of the packed components, in the same order
+    const std::vector<Entity>& GetEntities() const { return m_Entities; }
+    size_t GetSize() const { return m_Entities.size(); }
+protected:
+    static constexpr uint32_t InvalidSlot = UINT32_MAX;
+
+    // Entity index -> position in the packed arrays
+    std::vector<uint32_t> m_Sparse;
+    std::vector<Entity> m_Entities;
+};
+
+// Sparse set: components of one type packed contiguously whatever the entities they belong to, with O(1) add,
+// lookup and removal (the last component is moved into the hole, so the order is not stable).
+template<typename T>
+class ComponentPool : public ComponentPoolBase
+{
+public:
+    // Replaces the component when the entity already has one
+    template<typename... Args>
+    T& Add(const Entity entity, Args&&... args)
+    {
+        if (Contains(entity))
+        {
+            T& component = Get(entity);
+            component = T{ std::forward<Args>(args)... };
+            return component;
+        }
+
+        const uint32_t index = GetEntityIndex(entity);
+        if (index >= m_Sparse.size())
+            m_Sparse.resize(index + 1, InvalidSlot);
+
+        m_Sparse[index] = static_cast<uint32_t>(m_Entities.size());
+        m_Entities.push_back(entity);
+        m_Components.push_back(T{ std::forward<Args>(args)... });
+        return m_Components.back();
+    }
+
+    void Remove(const Entity entity) override
+    {
+        if (!Contains(entity))
+            return;
+
+        const uint32_t slot = m_Sparse[GetEntityIndex(entity)];
+        const Entity last = m_Entities.back();
+
+        m_Entities[slot] = last;
+        m_Components[slot] = std::move(m_Components.back());
+        m_Sparse[GetEntityIndex(last)] = slot;
+        m_Sparse[GetEntityIndex(entity)] = InvalidSlot;
+
+        m_Entities.pop_back();
+        m_Components.pop_back();
+    }
+
+    // The entity must have the component
+    T& Get(const Entity entity) { return m_Components[m_Sparse[GetEntityIndex(entity)]]; }
+    const T& Get(const Entity entity) const { return m_Components[m_Sparse[GetEntityIndex(entity)]]; }
+
+    T* TryGet(const Entity entity) { return Contains(entity) ? &Get(entity) : nullptr; }
+
+    std::vector<T>& GetComponents() { return m_Components; }
+    const std::vector<T>& GetComponents() const { return m_Components; }
+private:
+    std::vector<T> m_Components;
+};
@@ -0,0 +1,166 @@
+#pragma once
+
+#include "ComponentPool.h"
+
+#include <cassert>
+#include <memory>
+#include <tuple>
+
+// Owns the entities of a scene and one component pool per component type. Components are plain structs, systems
+// are loops over Each (or directly over a pool's packed arrays), no per-object virtual dispatch is involved.
+//
+//     registry.Each<Transform, Velocity>([deltaTime](Entity, Transform& transform, const Velocity& velocity)
+//     {
+//         transform.Position += velocity.Value * deltaTime;
+//     });
+class Registry
+{
+public:
+    Registry() = default;
+    Registry(const Registry& other) = delete;
+
+    // At most 2^20 - 1 entity slots, reused once destroyed: past that Create asserts and returns NullEntity
+    Entity Create()
+    {
+        if (m_FirstFree != NullEntity)
+        {
+            // The slot keeps the version bumped by Destroy
+            const uint32_t index = m_FirstFree;
+            const uint32_t next = m_Slots[index] & EntityIndexMask;
+            m_FirstFree = next == EntityIndexMask ? NullEntity : next;
+            m_Slots[index] = (m_Slots[index] & EntityVersionMask) | index;
+            m_AliveCount++;
+            return m_Slots[index];
+        }
+
+        // All ones in the index bits ends the free list and must never be a live index
+        assert(m_Slots.size() < EntityIndexMask && "Registry: Out of entity slots");
+        if (m_Slots.size() >= EntityIndexMask)
+            return NullEntity;
+
+        const auto index = static_cast<uint32_t>(m_Slots.size());
+        m_Slots.push_back(index);
+        m_AliveCount++;
+        return index;
+    }
+
+    void Destroy(const Entity entity)
+    {
+        if (!IsValid(entity))
+            return;
+
+        for (const auto& pool : m_Pools)
+        {
+            if (pool)
+                pool->Remove(entity);
+        }
+
+        // Free slots are chained through their index bits (all ones ends the chain); a slot that ran out of
+        // versions is retired rather than handing out a handle equal to an old one
+        const uint32_t index = GetEntityIndex(entity);
+        const uint32_t version = GetEntityVersion(entity) + 1;
+        m_AliveCount--;
+        if (version > (EntityVersionMask >> EntityIndexBits))
+        {
+            m_Slots[index] = NullEntity;
+            return;
+        }
+
+        m_Slots[index] = (version << EntityIndexBits) | (m_FirstFree == NullEntity ? EntityIndexMask : m_FirstFree);
+        m_FirstFree = index;
+    }
+
+    bool IsValid(const Entity entity) const
+    {
+        const uint32_t index = GetEntityIndex(entity);
+        return entity != NullEntity && index < m_Slots.size() && m_Slots[index] == entity;
+    }
+
+    uint32_t GetAliveCount() const { return m_AliveCount; }
+
+    template<typename T, typename... Args>
+    T& Add(const Entity entity, Args&&... args) { return GetPool<T>().Add(entity, std::forward<Args>(args)...); }
+
+    template<typename T>
+    void Remove(const Entity entity) { GetPool<T>().Remove(entity); }
+
+    template<typename T>
+    bool Has(const Entity entity) const
+    {
+        const ComponentPool<T>* pool = FindPool<T>();
+        return pool != nullptr && pool->Contains(entity);
+    }
+
+    template<typename T>
+    T& Get(const Entity entity) { return GetPool<T>().Get(entity); }
+
+    template<typename T>
+    T* TryGet(const Entity entity) { return GetPool<T>().TryGet(entity); }
+
+    template<typename T>
+    ComponentPool<T>& GetPool()
+    {
+        const uint32_t id = GetComponentId<T>();
+        if (id >= m_Pools.size())
+            m_Pools.resize(id + 1);
+        if (!m_Pools[id])
+            m_Pools[id] = std::make_unique<ComponentPool<T>>();
+        return static_cast<ComponentPool<T>&>(*m_Pools[id]);
+    }
+
+    // Calls function(entity, components&...) for every entity that has all the components. The smallest pool drives
+    // the loop; with a single component type this is a straight walk over the packed array.
+    // The function must not add or remove components of the iterated types.
+    template<typename... T, typename Function>
+    void Each(Function&& function)
+    {
+        static_assert(sizeof...(T) > 0, "Each needs at least one component type");
+
+        std::tuple<ComponentPool<T>&...> pools(GetPool<T>()...);
+        if constexpr (sizeof...(T) == 1)
+        {
+            auto& pool = std::get<0>(pools);
+            auto& components = pool.GetComponents();
+            const std::vector<Entity>& entities = pool.GetEntities();
+            for (size_t i = 0; i < entities.size(); i++)
+                function(entities[i], components[i]);
+        }
+        else
+        {
+            const ComponentPoolBase* driver = nullptr;
+            std::apply([&driver](auto&... pool)
+            {
+                ((driver = driver == nullptr || pool.GetSize() < driver->GetSize() ? &pool : driver), ...);
+            }, pools);
+
+            for (const Entity entity : driver->GetEntities())
+            {
+                if (std::apply([entity](auto&... pool) { return (pool.Contains(entity) && ...); }, pools))
+                    function(entity, std::get<ComponentPool<T>&>(pools).Get(entity)...);
+            }
+        }
+    }
+private:
+    template<typename T>
+    const ComponentPool<T>* FindPool() const
+    {
+        const uint32_t id = GetComponentId<T>();
+        return id < m_Pools.size() ? static_cast<const ComponentPool<T>*>(m_Pools[id].get()) : nullptr;
+    }
+
+    template<typename T>
+    static uint32_t GetComponentId()
+    {
+        static const uint32_t id = s_NextComponentId++;
+        return id;
+    }
+private:
+    // Per slot: the live entity handle, or for free slots the next version and the next free slot
+    std::vector<Entity> m_Slots;
+    uint32_t m_FirstFree = NullEntity;
+    uint32_t m_AliveCount = 0;
+
+    std::vector<std::unique_ptr<ComponentPoolBase>> m_Pools;
+
+    static inline uint32_t s_NextComponentId = 0;
+};
@@ -1,11 +1,101 @@
 #include "Game.h"
+#include "Debug/Profiler.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
 
 constexpr unsigned int SCREEN_WIDTH = 800;
 constexpr unsigned int SCREEN_HEIGHT = 600;
 
+// Usage: Breakout [--headless [--render]] [--golden <directory> [--update]] [--ticks <count>] [--frames <count>]
+//                 [--trace <file.json>] [--stats <file.txt>] [--hitch <milliseconds>]
+// Headless runs default to 10000 ticks, --ticks 0 keeps going until the game is won or lost (or an hour of simulated
+// time has passed).
+// Golden runs compare 60 frames by default against <directory>/frame_NNNN.png and exit with EXIT_FAILURE when a frame
+// differs or has no reference; --update writes the references instead. Without a display they fall back to GLFW's
+// null platform with an OSMesa software context, which needs osmesa.dll (libOSMesa.so) next to the executable;
+// alternatively run them under a virtual display such as Xvfb.
+// Any mode exits with EXIT_FAILURE when the window or the OpenGL context cannot be created.
+// --trace writes the profiler zones of the last frames as a Chrome trace on exit.
+// Frame statistics are printed on exit, --stats also writes them to a file; frames over --hitch ms (33.3 by default)
+// are reported as hitches.
 int main(int argc, char** argv)
 {
-    auto* game = new Game(SCREEN_WIDTH, SCREEN_HEIGHT, "Breakout");
-    game->Run();
+    RunMode mode = RunMode::Windowed;
+    bool render = false;
+    bool update = false;
+    uint64_t ticks = 10000;
+    uint32_t frames = 60;
+    std::string goldenDirectory;
+    std::string tracePath;
+    std::string statsPath;
+    double hitchThreshold = 0.0;
+    for (int i = 1; i < argc; i++)
+    {
+        if (std::strcmp(argv[i], "--headless") == 0)
+            mode = RunMode::Headless;
+        else if (std::strcmp(argv[i], "--render") == 0)
+            render = true;
+        else if (std::strcmp(argv[i], "--golden") == 0 && i + 1 < argc)
+        {
+            mode = RunMode::Golden;
+            goldenDirectory = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--update") == 0)
+            update = true;
+        else if (std::strcmp(argv[i], "--ticks") == 0 && i + 1 < argc)
+            ticks = std::strtoull(argv[++i], nullptr, 10);
+        else if (std::strcmp(argv[i], "--frames") == 0 && i + 1 < argc)
+            frames = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        else if (std::strcmp(argv[i], "--trace") == 0 && i + 1 < argc)
+            tracePath = argv[++i];
+        else if (std::strcmp(argv[i], "--stats") == 0 && i + 1 < argc)
+            statsPath = argv[++i];
+        else if (std::strcmp(argv[i], "--hitch") == 0 && i + 1 < argc)
+            hitchThreshold = std::strtod(argv[++i], nullptr);
+    }
+
+    int result = EXIT_SUCCESS;
+    auto* game = new Game(SCREEN_WIDTH, SCREEN_HEIGHT, "Breakout", mode);
+    if (!game->IsInitialized())
+    {
+        // The cause has been reported, golden runs in CI must not pass without having rendered anything
+        std::cout << "[ERROR] Game: Initialization failed, exiting." << '\n';
+        delete game;
+        return EXIT_FAILURE;
+    }
+    if (hitchThreshold > 0.0)
+        game->GetFrameStatistics().SetHitchThreshold(hitchThreshold);
+
+    switch (mode)
+    {
+        case RunMode::Headless:
+            game->RunHeadless(ticks, render);
+            break;
+        case RunMode::Golden:
+            if (game->RunGolden(goldenDirectory, frames, update) > 0)
+                result = EXIT_FAILURE;
+            break;
+        default:
+            game->Run();
+            break;
+    }
+
+    game->GetFrameStatistics().WriteSummary(std::cout);
+    if (!statsPath.empty())
+    {
+        std::ofstream statsFile(statsPath, std::ios::trunc);
+        game->GetFrameStatistics().WriteSummary(statsFile);
+        if (!statsFile)
+            std::cout << "[ERROR] FrameStatistics: Failed to write '" << statsPath << "'" << '\n';
+    }
     delete game;
-}
\ No newline at end of file
+
+    if (!tracePath.empty())
+        Profiler::WriteTrace(tracePath);
+
+    return result;
+}
@@ -1,75 +1,421 @@
 ﻿#include "Game.h"
 
+#include "Debug/AllocationCounter.h"
+#include "Debug/GoldenImage.h"
+#include "Debug/Profiler.h"
+#include "Jobs/JobSystem.h"
+#include "Memory/FrameArena.h"
+#include "Renderer/Framebuffer.h"
+#include "Renderer/NullRendererAPI.h"
+#include "Renderer/ParticleSystem.h"
 #include "Renderer/Renderer.h"
+#include "Renderer/Shader.h"
+#include "Renderer/ShaderCache.h"
+#include "Renderer/Texture2D.h"
 #include "ResourceManager.h"
 
 #include <glad/glad.h>
 #include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
 
+#include <chrono>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
 #include <iostream>
 
-Game::Game(const int width, const int height, const char* title)
-    : m_Width(width), m_Height(height), m_Title(title)
+namespace
 {
-    Initialize();
+    // Software rasterizers differ slightly in blending and filtering precision
+    constexpr int GoldenTolerance = 2;
+    constexpr double GoldenMaxMismatchRatio = 0.001;
+
+    constexpr double OverlayRefreshInterval = 0.5;
+
+    // Headless runs until the game ends give up after this much simulated time (nothing feeds them input)
+    constexpr double HeadlessMaxSimulatedSeconds = 3600.0;
+
+    // About two ball diameters: a ball spans at most 4 cells
+    constexpr float BroadphaseCellSize = 32.0f;
+
+    // Per frame arena, grown on demand
+    constexpr size_t FrameArenaCapacity = 1024 * 1024;
+
+    // Debris and trails of a few balls, 192 KB per particle buffer
+    constexpr uint32_t ParticleCapacity = 4096;
+    constexpr float ParticleGravity = 400.0f;
+
+    // Level: rows of bricks, the top ones take more hits
+    constexpr uint32_t BrickColumns = 14;
+    constexpr uint32_t BrickRows = 6;
+    constexpr glm::vec2 BrickOrigin(36.0f, 60.0f);
+    constexpr glm::vec2 BrickCellSize(52.0f, 24.0f);
+    constexpr float BrickPadding = 2.0f;
+    // Indexed by hit points - 1
+    constexpr glm::vec4 BrickColors[] = {
+        { 0.95f, 0.85f, 0.30f, 1.0f },
+        { 0.95f, 0.55f, 0.20f, 1.0f },
+        { 0.85f, 0.25f, 0.25f, 1.0f }
+    };
+
+    constexpr float BallRadius = 8.0f;
+    constexpr float BallSpeed = 420.0f;
+    constexpr int BallTextureSize = 32;
+    constexpr float WallThickness = 32.0f;
+    constexpr uint32_t DebrisPerBrick = 24;
+}
+
+Game::Game(const int width, const int height, const char* title, const RunMode mode /* = RunMode::Windowed */)
+    : m_State(ACTIVE), m_Mode(mode), m_Width(width), m_Height(height), m_Title(title),
+      m_Bodies(glm::vec2(static_cast<float>(width), static_cast<float>(height)), BroadphaseCellSize),
+      m_Bricks(BrickColumns, BrickRows, BrickOrigin, BrickCellSize)
+{
+    Profiler::SetThreadName("Main");
+    JobSystem::Initialize();
+    FrameArena::Initialize(FrameArenaCapacity);
+    ResetLevel();
+
+    m_Initialized = m_Mode == RunMode::Headless || Initialize();
 }
 
 Game::~Game()
 {
-    ResourceManager::Instance().Clear();
-    Renderer::Shutdown();
+    if (m_Mode != RunMode::Headless)
+    {
+        if (m_Initialized)
+        {
+            ResourceManager::Instance().Clear();
+            DestroyGraphics();
+            Renderer::Shutdown();
+        }
 
-    glfwDestroyWindow(m_Window);
-    glfwTerminate();
+        if (m_Window != nullptr)
+            glfwDestroyWindow(m_Window);
+        glfwTerminate();
+    }
+
+    JobSystem::Shutdown();
+    FrameArena::Shutdown();
 }
 
 void Game::Run()
 {
+    m_LastFrameTime = glfwGetTime();
+
     while (!glfwWindowShouldClose(m_Window))
     {
-        float currentFrame = static_cast<float>(glfwGetTime());
-        m_DeltaTime = currentFrame - m_LastFrameTime;
+        PROFILE_SCOPE("Frame");
+        const uint64_t frameStart = Profiler::Now();
+        FrameArena::BeginFrame();
+
+        const double currentFrame = glfwGetTime();
+        m_DeltaTime = static_cast<float>(currentFrame - m_LastFrameTime);
         m_LastFrameTime = currentFrame;
 
-        glfwPollEvents();
+        {
+            PROFILE_SCOPE("PollEvents");
+            glfwPollEvents();
+        }
 
         // Process user input
         ProcessInput();
 
         // Update game state
-        Update();
+        const float alpha = AdvanceSimulation(m_DeltaTime);
+
+        // Upload textures decoded in the background since last frame
+        ResourceManager::Instance().ProcessUploads(2.0);
 
         // Render scene
-        Render();
+        Renderer::ResetStats();
+        Shader::ResetUploadStats();
+        Renderer::SetClearColor(glm::vec4(0.15f, 0.15f, 0.15f, 1.0f));
+        Renderer::Clear();
+
+        Render(alpha);
 
+        if (m_LastFrameTime - m_LastOverlayUpdate >= OverlayRefreshInterval)
+            UpdateTitleOverlay();
+
+        {
+            PROFILE_SCOPE("SwapBuffers");
+            glfwSwapBuffers(m_Window);
+        }
+
+        m_FrameStats.RecordFrame(frameStart, Profiler::Now());
+    }
+}
+
+float Game::AdvanceSimulation(const double frameTime)
+{
+    // Fixed steps, a hitch runs at most m_MaxTicksPerFrame ticks and drops the rest
+    m_Accumulator += frameTime;
+    int ticks = 0;
+    while (m_Accumulator >= m_TickDuration && ticks < m_MaxTicksPerFrame)
+    {
+        const uint64_t tickStart = Profiler::Now();
+        Update(static_cast<float>(m_TickDuration));
+        m_FrameStats.RecordTick(tickStart, Profiler::Now());
+        m_Accumulator -= m_TickDuration;
+        m_TickCount++;
+        ticks++;
+    }
+    m_PendingParticleTicks += ticks;
+    if (ticks == m_MaxTicksPerFrame && m_Accumulator >= m_TickDuration)
+        m_Accumulator = std::fmod(m_Accumulator, m_TickDuration);
+
+    return static_cast<float>(m_Accumulator / m_TickDuration);
+}
+
+Game::HeadlessResult Game::RunHeadless(const uint64_t maxTicks, const bool render, const uint64_t warmupTicks /* = 60 */)
+{
+    // Frames are built on the recording backend, nothing reaches a GPU
+    NullRendererAPI* recorder = nullptr;
+    NullRendererAPI::Counters frameTotals;
+    if (render)
+    {
+        Renderer::Initialize(RendererAPI::API::Null);
+        Renderer::SetViewport(0, 0, m_Width, m_Height);
+        recorder = &static_cast<NullRendererAPI&>(RendererAPI::Get());
+        CreateGraphics();
+        recorder->Reset();
+    }
+
+    // Virtual clock: every iteration advances simulated time by exactly one tick
+    const auto startTime = std::chrono::steady_clock::now();
+    const uint64_t firstTick = m_TickCount;
+    HeadlessResult result;
+    double virtualTime = 0.0;
+
+    while ((maxTicks == 0 && m_State == ACTIVE) || m_TickCount - firstTick < maxTicks)
+    {
+        if (maxTicks == 0 && virtualTime >= HeadlessMaxSimulatedSeconds)
+        {
+            std::cout << "| [WARNING] Headless: Game still running after " << HeadlessMaxSimulatedSeconds << " s simulated, stopping" << '\n';
+            break;
+        }
+
+        const uint64_t tickAllocations = AllocationCounter::GetCount();
+        const uint64_t tickImpacts = m_ImpactCount;
+        FrameArena::BeginFrame();
+        ProcessInput();
+        const uint64_t tickStart = Profiler::Now();
+        Update(static_cast<float>(m_TickDuration));
+        m_FrameStats.RecordTick(tickStart, Profiler::Now());
+
+        virtualTime += m_TickDuration;
+        m_TickCount++;
+
+        if (recorder != nullptr)
+        {
+            m_LastFrameTime = virtualTime;
+            m_DeltaTime = static_cast<float>(m_TickDuration);
+            m_PendingParticleTicks = 1;
+            Renderer::ResetStats();
+            Renderer::Clear();
+            Render(0.0f);
+
+            const NullRendererAPI::Counters& counters = recorder->GetCounters();
+            frameTotals.Commands += counters.Commands;
+            frameTotals.DrawCalls += counters.DrawCalls;
+            frameTotals.StateChanges += counters.StateChanges;
+            frameTotals.BytesUploaded += counters.BytesUploaded;
+            recorder->Reset();
+        }
+
+        if (m_TickCount - firstTick > warmupTicks)
+        {
+            const uint64_t allocations = AllocationCounter::GetCount() - tickAllocations;
+            result.Allocations += allocations;
+            result.MaxTickAllocations = std::max(result.MaxTickAllocations, allocations);
+
+            result.Impacts += m_ImpactCount - tickImpacts;
+            if (recorder != nullptr)
+            {
+                result.Quads += Renderer::GetStats().QuadCount;
+                result.DrawCalls += Renderer::GetStats().DrawCalls;
+                result.ParticleBytes += Renderer::GetStats().ParticleBytesUploaded;
+            }
+        }
+    }
+
+    const uint64_t ticks = m_TickCount - firstTick;
+    result.Ticks = ticks;
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+    std::cout << "| [INFO] Headless: " << ticks << " ticks (" << virtualTime << " s simulated) in "
+        << seconds * 1000.0 << " ms, " << (seconds > 0.0 ? ticks / seconds : 0.0) << " ticks/s" << '\n';
+
+    if (AllocationCounter::Enabled && ticks > warmupTicks)
+    {
+        std::cout << "| [INFO] Headless: " << static_cast<double>(result.Allocations) / (ticks - warmupTicks)
+            << " heap allocations per tick after " << warmupTicks << " warm-up ticks (max " << result.MaxTickAllocations
+            << "), frame arena peak " << FrameArena::GetPeak() << " bytes" << '\n';
+    }
+
+    if (recorder != nullptr && ticks > 0)
+    {
+        std::cout << "| [INFO] Headless: Per frame: " << static_cast<double>(frameTotals.Commands) / ticks << " commands, "
+            << static_cast<double>(frameTotals.DrawCalls) / ticks << " draw calls, "
+            << static_cast<double>(frameTotals.StateChanges) / ticks << " state changes, "
+            << static_cast<double>(frameTotals.BytesUploaded) / ticks << " bytes uploaded" << '\n';
+    }
+
+    if (recorder != nullptr)
+    {
+        DestroyGraphics();
+        Renderer::Shutdown();
+    }
+
+    return result;
+}
+
+int Game::RunGolden(const std::string& directory, const uint32_t frameCount, const bool update)
+{
+    constexpr double frameTime = 1.0 / 60.0;
+    const auto maxMismatchedPixels = static_cast<uint32_t>(m_Width * m_Height * GoldenMaxMismatchRatio);
+
+    std::error_code error;
+    std::filesystem::create_directories(directory, error);
+
+    Framebuffer target(m_Width, m_Height);
+    std::vector<unsigned char> pixels;
+    std::vector<double> updateMilliseconds, renderMilliseconds;
+    int failures = 0;
+
+    for (uint32_t frame = 0; frame < frameCount; frame++)
+    {
+        // Virtual clock: every run goes through the exact same simulation steps
+        const auto startTime = std::chrono::steady_clock::now();
+        FrameArena::BeginFrame();
+        m_DeltaTime = static_cast<float>(frameTime);
+        m_LastFrameTime += frameTime;
+
+        ProcessInput();
+        const float alpha = AdvanceSimulation(frameTime);
+        const auto updateTime = std::chrono::steady_clock::now();
+
+        target.Bind();
+        Renderer::SetViewport(0, 0, m_Width, m_Height);
         Renderer::SetClearColor(glm::vec4(0.15f, 0.15f, 0.15f, 1.0f));
         Renderer::Clear();
+        Render(alpha);
+        Renderer::Finish();
+        const auto renderTime = std::chrono::steady_clock::now();
+
+        updateMilliseconds.push_back(std::chrono::duration<double, std::milli>(updateTime - startTime).count());
+        renderMilliseconds.push_back(std::chrono::duration<double, std::milli>(renderTime - updateTime).count());
+
+        target.ReadPixels(pixels);
+        const GoldenImage actual(m_Width, m_Height, pixels);
 
-        glfwSwapBuffers(m_Window);
+        char name[32];
+        std::snprintf(name, sizeof(name), "frame_%04u", frame);
+        const std::string goldenPath = directory + "/" + name + ".png";
+
+        if (update)
+        {
+            if (!actual.Save(goldenPath))
+            {
+                std::cout << "[ERROR] Golden: Failed to write '" << goldenPath << "'" << '\n';
+                failures++;
+            }
+            continue;
+        }
+
+        // A wrong or empty directory must fail, not quietly become the new references
+        GoldenImage expected;
+        if (!expected.Load(goldenPath))
+        {
+            std::cout << "[ERROR] Golden: No reference '" << goldenPath << "', run with --update to create it" << '\n';
+            failures++;
+            continue;
+        }
+
+        const GoldenImage::Comparison comparison = actual.Compare(expected, GoldenTolerance);
+        if (!comparison.Passed(maxMismatchedPixels))
+        {
+            // Kept next to the reference for inspection
+            actual.Save(directory + "/" + name + ".actual.png");
+            std::cout << "[ERROR] Golden: " << name << " differs: " << comparison.MismatchedPixels << " pixels off by more than "
+                << GoldenTolerance << " (max difference " << comparison.MaxDifference << (comparison.SizeMismatch ? ", size mismatch" : "") << ")" << '\n';
+            failures++;
+        }
     }
+
+    target.Unbind();
+
+    std::ofstream timings(directory + "/timings.csv", std::ios::trunc);
+    timings << "frame,update_ms,render_ms" << '\n';
+    for (size_t i = 0; i < renderMilliseconds.size(); i++)
+        timings << i << ',' << updateMilliseconds[i] << ',' << renderMilliseconds[i] << '\n';
+
+    if (!renderMilliseconds.empty())
+    {
+        double total = 0.0;
+        for (const double milliseconds : renderMilliseconds)
+            total += milliseconds;
+        std::cout << "| [INFO] Golden: " << frameCount - failures << "/" << frameCount << (update ? " frames written" : " frames match") << ", render CPU time avg "
+            << total / renderMilliseconds.size() << " ms, max " << *std::max_element(renderMilliseconds.begin(), renderMilliseconds.end()) << " ms" << '\n';
+    }
+
+    return failures;
 }
 
-void Game::Initialize()
+bool Game::Initialize()
 {
+    PROFILE_SCOPE("Initialize");
+    const auto startTime = std::chrono::steady_clock::now();
+
     // Initialize window
-    glfwInit();
-    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
-    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
-    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+    const auto createWindow = [this]()
+    {
+        glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+        glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+        glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
 #ifdef __APPLE__
-    glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
+        glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
 #endif
-    glfwWindowHint(GLFW_RESIZABLE, true);
+        glfwWindowHint(GLFW_RESIZABLE, true);
+        // Golden runs render offscreen, the window only provides the context
+        glfwWindowHint(GLFW_VISIBLE, m_Mode != RunMode::Golden);
+        m_Window = glfwCreateWindow(m_Width, m_Height, m_Title.c_str(), nullptr, nullptr);
+    };
+
+    if (glfwInit())
+        createWindow();
+    else if (m_Mode != RunMode::Golden)
+        std::cout << "[ERROR] Game: Failed to initialize GLFW." << '\n';
+
+    // CI machines have neither a display nor a GPU: GLFW's null platform needs no display, and an OSMesa context
+    // (Mesa's software rasterizer, osmesa.dll / libOSMesa.so) renders without a GPU
+    if (m_Window == nullptr && m_Mode == RunMode::Golden)
+    {
+        std::cout << "| [WARNING] Game: No window for the golden run, falling back to an offscreen OSMesa context" << '\n';
+        glfwTerminate();
+        glfwInitHint(GLFW_PLATFORM, GLFW_PLATFORM_NULL);
+        if (glfwInit())
+        {
+            glfwWindowHint(GLFW_CONTEXT_CREATION_API, GLFW_OSMESA_CONTEXT_API);
+            createWindow();
+        }
+    }
 
-    m_Window = glfwCreateWindow(m_Width, m_Height, m_Title.c_str(), nullptr, nullptr);
+    if (m_Window == nullptr)
+    {
+        // Typically no display, or no OpenGL 3.3 core profile driver
+        std::cout << "[ERROR] Game: Failed to create the window and its OpenGL 3.3 context." << '\n';
+        return false;
+    }
     glfwMakeContextCurrent(m_Window);
 
     // glad: Load all OpenGL function pointers
     // ---------------------------------------
     if (!gladLoadGLLoader(reinterpret_cast<GLADloadproc>(glfwGetProcAddress)))
     {
-        std::cout << "Failed to initialize GLAD." << '\n';
-        return;
+        std::cout << "[ERROR] Game: Failed to initialize GLAD." << '\n';
+        return false;
     }
 
     // Allows us to access the Application instance from GLFW callbacks
@@ -91,24 +437,263 @@ void Game::Initialize()
         game->OnWindowResize(width, height);
     });
 
+    // Program binaries are cached next to the executable, must be set up before the first shader is compiled
+    ShaderCache::Initialize("cache/shaders", reinterpret_cast<ShaderCache::ProcLoader>(glfwGetProcAddress));
+
+    // Packed assets, when present, replace the loose files
+    ResourceManager::Instance().MountAssetPack("assets.pak");
+
     // OpenGL Renderer setup
     Renderer::Initialize();
     Renderer::SetViewport(0, 0, m_Width, m_Height);
+
+    CreateGraphics();
+
+    const auto& shaderStats = ShaderCache::GetStats();
+    const double startupMilliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+    std::cout << "| [INFO] Startup: " << startupMilliseconds << " ms (shaders: "
+        << shaderStats.Hits << " cached in " << shaderStats.LoadMilliseconds << " ms, "
+        << shaderStats.Misses << " compiled in " << shaderStats.CompileMilliseconds << " ms)" << '\n';
+
+    return true;
+}
+
+void Game::ResetLevel()
+{
+    m_State = ACTIVE;
+
+    m_Bricks.Clear();
+    for (uint32_t row = 0; row < BrickRows; row++)
+    {
+        const auto hitPoints = static_cast<uint8_t>(3 - row / 2);
+        for (uint32_t column = 0; column < BrickColumns; column++)
+            m_Bricks.SetBrick(column, row, hitPoints, BrickPadding);
+    }
+
+    const glm::vec2 field(static_cast<float>(m_Width), static_cast<float>(m_Height));
+    m_Walls = {
+        { { -WallThickness, -WallThickness }, { 0.0f, field.y + WallThickness } },
+        { { field.x, -WallThickness }, { field.x + WallThickness, field.y + WallThickness } },
+        { { 0.0f, -WallThickness }, { field.x, 0.0f } },
+        { { 0.0f, field.y }, { field.x, field.y + WallThickness } }
+    };
+
+    // Launched upwards from below the wall, fanned out so that they meet each other as well as the bricks
+    const glm::vec2 launch(field.x * 0.5f, field.y * 0.75f);
+    const glm::vec2 balls[][2] = {
+        { launch + glm::vec2(-100.0f, 0.0f), { -0.5f, -1.0f } },
+        { launch, { 0.15f, -1.0f } },
+        { launch + glm::vec2(100.0f, 0.0f), { 0.6f, -1.0f } }
+    };
+
+    m_Bodies.Clear();
+    m_Balls.clear();
+    m_PreviousBallPositions.clear();
+    m_BallBodies.clear();
+    for (const auto& ball : balls)
+    {
+        const glm::vec2 extent(BallRadius);
+        m_BallBodies.push_back(m_Bodies.Insert(ball[0] - extent, ball[0] + extent, static_cast<uint32_t>(m_Balls.size())));
+        m_Balls.push_back({ ball[0], glm::normalize(ball[1]) * BallSpeed, BallRadius });
+        m_PreviousBallPositions.push_back(ball[0]);
+    }
+}
+
+void Game::CreateGraphics()
+{
+    // White disc with an antialiased edge, tinted per ball
+    std::vector<unsigned char> pixels(BallTextureSize * BallTextureSize * 4, 255);
+    const float center = BallTextureSize * 0.5f;
+    for (int y = 0; y < BallTextureSize; y++)
+    {
+        for (int x = 0; x < BallTextureSize; x++)
+        {
+            const float distance = glm::length(glm::vec2(x + 0.5f, y + 0.5f) - center);
+            const float coverage = glm::clamp(center - distance, 0.0f, 1.0f);
+            pixels[(y * BallTextureSize + x) * 4 + 3] = static_cast<unsigned char>(coverage * 255.0f);
+        }
+    }
+
+    m_BallTexture = std::make_shared<Texture2D>(BallTextureSize, BallTextureSize, 4);
+    m_BallTexture->Bind();
+    m_BallTexture->SetData(pixels.data(), TextureFormat::RGBA, PixelType::UnsignedByte);
+    m_BallTexture->SetFilterMode(TextureFilter::Linear);
+    m_BallTexture->SetWrapMode(TextureWrap::ClampToEdge);
+    m_BallTexture->Unbind();
+
+    m_Particles = std::make_unique<ParticleSystem>(ParticleCapacity);
+    m_Particles->SetGravity(glm::vec2(0.0f, ParticleGravity));
+}
+
+void Game::DestroyGraphics()
+{
+    // Textures do not release their storage themselves
+    if (m_BallTexture)
+        RendererAPI::Get().DeleteTexture(m_BallTexture->GetID());
+    m_BallTexture.reset();
+    m_Particles.reset();
 }
 
 void Game::ProcessInput()
 {
+    PROFILE_SCOPE("ProcessInput");
+
     // TODO
 }
 
-void Game::Update()
+void Game::Update(const float deltaTime)
 {
-    // TODO
+    PROFILE_SCOPE("Update");
+
+    if (m_State != ACTIVE)
+        return;
+
+    // Collision lists of this tick live in the frame arena, sized for the largest possible results: every impact of
+    // a move, every brick, every ball
+    FrameVector<Collision::Impact> impacts;
+    impacts.reserve(Collision::MaxImpactsPerMove);
+    FrameVector<uint32_t> scratchBricks;
+    scratchBricks.reserve(m_Bricks.GetStride() * m_Bricks.GetRows());
+    FrameVector<uint32_t> nearbyBodies;
+    nearbyBodies.reserve(m_Balls.size());
+
+    for (size_t i = 0; i < m_Balls.size(); i++)
+    {
+        Collision::Ball& ball = m_Balls[i];
+        m_PreviousBallPositions[i] = ball.Position;
+        impacts.clear();
+        Collision::MoveBall(ball, deltaTime, m_Bricks, m_Walls, impacts, scratchBricks);
+        m_ImpactCount += impacts.size();
+
+        const glm::vec2 extent(ball.Radius);
+        m_Bodies.Move(m_BallBodies[i], ball.Position - extent, ball.Position + extent);
+
+        if (!m_Particles)
+            continue;
+        for (const Collision::Impact& impact : impacts)
+        {
+            if (impact.Type != Collision::Target::Brick || !impact.Destroyed)
+                continue;
+
+            // Debris sprays out of the brick, away from the ball
+            ParticleSystem::Burst debris;
+            debris.Position = (m_Bricks.GetMin(impact.Index) + m_Bricks.GetMax(impact.Index)) * 0.5f;
+            debris.Direction = -impact.Normal;
+            debris.Spread = 1.2f;
+            debris.Color = BrickColors[0];
+            m_Particles->Emit(debris, DebrisPerBrick);
+        }
+    }
+
+    // Balls bounce off each other as equal masses: their velocities along the line between the centers are swapped
+    for (size_t i = 0; i < m_Balls.size(); i++)
+    {
+        Collision::Ball& ball = m_Balls[i];
+        const glm::vec2 extent(ball.Radius);
+        nearbyBodies.clear();
+        m_Bodies.QueryAABB(ball.Position - extent, ball.Position + extent, nearbyBodies);
+
+        for (const uint32_t body : nearbyBodies)
+        {
+            const uint32_t other = m_Bodies.GetUserData(body);
+            if (other <= i)
+                continue;
+
+            Collision::Ball& otherBall = m_Balls[other];
+            const glm::vec2 offset = otherBall.Position - ball.Position;
+            const float distance = glm::length(offset);
+            if (distance <= 0.0f || distance >= ball.Radius + otherBall.Radius)
+                continue;
+
+            const glm::vec2 normal = offset / distance;
+            const float approach = glm::dot(ball.Velocity - otherBall.Velocity, normal);
+            if (approach <= 0.0f)
+                continue;
+            ball.Velocity -= approach * normal;
+            otherBall.Velocity += approach * normal;
+        }
+    }
+
+    if (m_Bricks.GetAliveCount() == 0)
+        m_State = WIN;
 }
 
-void Game::Render()
+void Game::Render(const float alpha)
 {
-    // TODO
+    PROFILE_SCOPE("Render");
+
+    const glm::mat4 projection = glm::ortho(0.0f, static_cast<float>(m_Width), static_cast<float>(m_Height), 0.0f, -1.0f, 1.0f);
+
+    Renderer::BeginFrame({ projection, glm::vec2(0.0f), static_cast<float>(m_LastFrameTime), m_DeltaTime });
+
+    Renderer::BeginPass("Sprites");
+    Renderer::BeginBatch();
+    for (uint32_t row = 0; row < m_Bricks.GetRows(); row++)
+    {
+        for (uint32_t column = 0; column < m_Bricks.GetColumns(); column++)
+        {
+            const uint32_t brick = m_Bricks.GetIndex(column, row);
+            if (m_Bricks.IsAlive(brick))
+                Renderer::Submit(m_Bricks.GetMin(brick), m_Bricks.GetMax(brick) - m_Bricks.GetMin(brick), BrickColors[m_Bricks.GetHitPoints(brick) - 1]);
+        }
+    }
+    for (size_t i = 0; i < m_Balls.size(); i++)
+    {
+        // Smooth at any refresh rate: the simulation runs at a fixed rate, frames fall between two ticks
+        const Collision::Ball& ball = m_Balls[i];
+        const glm::vec2 position = glm::mix(m_PreviousBallPositions[i], ball.Position, alpha);
+        Renderer::Submit(position - ball.Radius, glm::vec2(ball.Radius * 2.0f), *m_BallTexture, glm::vec4(0.85f, 0.9f, 1.0f, 1.0f));
+    }
+    Renderer::EndBatch();
+    Renderer::EndPass();
+
+    // Debris emitted by Update is uploaded here, then stepped on the GPU once per tick run since the last frame:
+    // fixed steps like the rest of the simulation, never the variable frame time
+    if (m_Particles)
+    {
+        Renderer::BeginPass("Particles");
+        for (uint32_t tick = 0; tick < m_PendingParticleTicks; tick++)
+            Renderer::UpdateParticles(*m_Particles, static_cast<float>(m_TickDuration));
+        Renderer::DrawParticles(*m_Particles);
+        Renderer::EndPass();
+    }
+    m_PendingParticleTicks = 0;
+}
+
+void Game::UpdateTitleOverlay()
+{
+    m_LastOverlayUpdate = m_LastFrameTime;
+
+    // Formatted in place, this runs inside the frame loop which must not touch the heap
+    char title[512];
+    size_t length = 0;
+    const auto append = [&title, &length](const char* format, auto... args)
+    {
+        const int written = std::snprintf(title + length, sizeof(title) - length, format, args...);
+        if (written > 0)
+            length = std::min(length + written, sizeof(title) - 1);
+    };
+
+    const DurationHistogram& frameTimes = m_FrameStats.GetRecentFrameTimes();
+    append("%s | p50 %.2f ms, p99 %.2f ms", m_Title.c_str(), frameTimes.GetPercentile(50.0), frameTimes.GetPercentile(99.0));
+    if (AllocationCounter::Enabled && frameTimes.GetCount() > 0)
+    {
+        const uint64_t allocations = AllocationCounter::GetCount();
+        append(" | %.1f allocations/frame", static_cast<double>(allocations - m_LastOverlayAllocations) / frameTimes.GetCount());
+        m_LastOverlayAllocations = allocations;
+    }
+    m_FrameStats.ResetRecent();
+
+    const char* separator = " | GPU ";
+    for (const Renderer::GpuPassTiming& timing : Renderer::GetGpuTimings())
+    {
+        append("%s%s %.2f ms", separator, timing.Name, timing.Milliseconds);
+        separator = ", ";
+    }
+    if (Renderer::GetStats().DroppedGpuPasses > 0)
+        append(" (%u passes over budget)", Renderer::GetStats().DroppedGpuPasses);
+
+    glfwSetWindowTitle(m_Window, title);
 }
 
 void Game::OnKeyPressed(int key, int scancode, int action, int mode)
@@ -127,5 +712,5 @@ void Game::OnKeyPressed(int key, int scancode, int action, int mode)
 
 void Game::OnWindowResize(const int width, const int height)
 {
-    glViewport(0, 0, width, height);
+    Renderer::SetViewport(0, 0, width, height);
 }
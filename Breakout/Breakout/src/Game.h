@@ -1,11 +1,22 @@
 ﻿#pragma once
 
+#include "Debug/FrameStatistics.h"
+#include "Level/BrickGrid.h"
+#include "Physics/Collision.h"
+#include "Physics/SpatialGrid.h"
+
+#include <algorithm>
+#include <memory>
 #include <string>
+#include <vector>
 
 // [CRITICAL] OpenGL function pointers must be included before GLFW !
 #include <glad/glad.h>
 #include <GLFW/glfw3.h>
 
+class ParticleSystem;
+class Texture2D;
+
 enum GameState : uint8_t
 {
     ACTIVE,
@@ -14,35 +25,125 @@ enum GameState : uint8_t
     LOST
 };
 
+enum class RunMode : uint8_t
+{
+    Windowed,
+    // No window nor GL context: only input and simulation run
+    Headless,
+    // Hidden window (or no window at all on GLFW's null platform), frames are rendered offscreen and compared against
+    // reference images
+    Golden
+};
+
 class Game
 {
 public:
-    Game(int width, int height, const char* title);
+    struct HeadlessResult
+    {
+        uint64_t Ticks = 0;
+        // Heap allocations made by the ticks (and frames) past the warm-up ones, in total and by the worst single
+        // tick. Always 0 unless allocations are counted (BREAKOUT_COUNT_ALLOCATIONS).
+        uint64_t Allocations = 0;
+        uint64_t MaxTickAllocations = 0;
+        // Work done by the same ticks: collisions resolved and, with render, quads batched, draw calls recorded and
+        // particle bytes uploaded
+        uint64_t Impacts = 0;
+        uint64_t Quads = 0;
+        uint64_t DrawCalls = 0;
+        uint64_t ParticleBytes = 0;
+    };
+
+    Game(int width, int height, const char* title, RunMode mode = RunMode::Windowed);
     Game(const Game& other) = delete;
     ~Game();
 
     GameState GetState() const { return m_State; }
+    // False when the window, the GL context or the GL function pointers could not be set up (no display, no
+    // OpenGL 3.3 driver): nothing may run then. Headless games always succeed.
+    bool IsInitialized() const { return m_Initialized; }
+    // Frame and tick times of every run mode, hitch threshold included
+    FrameStatistics& GetFrameStatistics() { return m_FrameStats; }
+
+    // Simulation runs at a fixed rate regardless of the display refresh rate, at least 1 tick per second
+    void SetTickRate(int ticksPerSecond) { m_TickDuration = 1.0 / std::max(ticksPerSecond, 1); }
+    // Upper bound on the ticks run in a single frame (at least 1), time beyond that is dropped instead of spiralling
+    void SetMaxTicksPerFrame(int maxTicks) { m_MaxTicksPerFrame = std::max(maxTicks, 1); }
+
+    // Runs maxTicks ticks (0 = until the state leaves ACTIVE, at most an hour of simulated time) as fast as possible
+    // on a virtual clock.
+    // With render, a frame is also built after every tick on the null renderer backend and its submission cost reported.
+    // The first warmupTicks ticks, during which pools and arenas grow, are left out of the allocation counts.
+    HeadlessResult RunHeadless(uint64_t maxTicks, bool render, uint64_t warmupTicks = 60);
 private:
-    void Initialize();
+    // Reports what failed and returns false when the game cannot render
+    bool Initialize();
 
     void Run();
+    // Renders frameCount frames on a virtual 60 Hz clock into an offscreen framebuffer and compares each one with
+    // <directory>/frame_<n>.png, or writes them all as the new references with update. A missing reference counts as
+    // a mismatch. Returns the number of frames that did not match (or could not be written).
+    int RunGolden(const std::string& directory, uint32_t frameCount, bool update);
+
+    // Runs the fixed-step updates covering frameTime, returns the interpolation alpha for rendering
+    float AdvanceSimulation(double frameTime);
+
+    // Brick wall and balls of the self-playing level, the same every run so that replays and golden frames match
+    void ResetLevel();
+    // Ball texture and particle system, on the renderer's current backend
+    void CreateGraphics();
+    void DestroyGraphics();
 
     void ProcessInput();
-    void Update();
-    void Render();
+    void Update(float deltaTime);
+    // alpha is how far the current frame lies between the previous and the current simulation state [0, 1)
+    void Render(float alpha);
+
+    // Recent frame time percentiles, heap allocations per frame (when counted) and per-pass GPU timings shown in the
+    // window title
+    void UpdateTitleOverlay();
 private:
     void OnKeyPressed(int key, int scancode, int action, int mode);
     void OnWindowResize(int width, int height);
 private:
     GameState m_State;
     GLFWwindow* m_Window = nullptr;
+    RunMode m_Mode;
+    bool m_Initialized = false;
 private:
     float m_DeltaTime = 0.0f;
-    float m_LastFrameTime = 0.0f;
+    double m_LastFrameTime = 0.0;
+    double m_LastOverlayUpdate = 0.0;
+    uint64_t m_LastOverlayAllocations = 0;
+
+    double m_TickDuration = 1.0 / 120.0;
+    double m_Accumulator = 0.0;
+    int m_MaxTicksPerFrame = 8;
+    uint64_t m_TickCount = 0;
+    // Ticks run since the particles were last stepped, the next frame catches up
+    uint32_t m_PendingParticleTicks = 0;
 
-    bool m_Keys[1024];
+    FrameStatistics m_FrameStats;
+
+    bool m_Keys[1024] = {};
     int m_Width, m_Height;
     std::string m_Title;
+
+    // Broad phase of the moving bodies (balls, power-ups), sized from the play field
+    SpatialGrid m_Bodies;
+    // Brick debris, simulated on the GPU (none in headless runs without render)
+    std::unique_ptr<ParticleSystem> m_Particles;
+
+    BrickGrid m_Bricks;
+    // Sides of the play field, the bottom one stands in for the paddle until there is input
+    std::vector<Collision::Box> m_Walls;
+    std::vector<Collision::Ball> m_Balls;
+    // Ball positions before the last tick, frames are drawn between those and the current ones
+    std::vector<glm::vec2> m_PreviousBallPositions;
+    // Handle of each ball in m_Bodies, whose user data is the ball's index
+    std::vector<uint32_t> m_BallBodies;
+    // Collisions resolved since the start
+    uint64_t m_ImpactCount = 0;
+    std::shared_ptr<Texture2D> m_BallTexture;
 private:
     friend int main(int argc, char** argv);
 };
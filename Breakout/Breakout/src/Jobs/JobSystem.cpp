@@ -0,0 +1,379 @@
+#include "JobSystem.h"
+
+#include "../Debug/Profiler.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <memory>
+#include <string>
+#include <thread>
+
+namespace
+{
+    struct Job
+    {
+        JobSystem::Function Function;
+        JobCounter* Counter = nullptr;
+    };
+
+    // The owner works at the back, thieves take from the front. A ring that only grows: once it has reached the
+    // depth a frame needs, queuing jobs no longer touches the heap (std::deque allocates and frees blocks as it moves).
+    struct JobQueue
+    {
+        std::mutex Mutex;
+        std::vector<Job> Ring = std::vector<Job>(64); // power of two
+        uint32_t Head = 0;
+        uint32_t Count = 0;
+
+        void PushBack(Job&& job)
+        {
+            const auto capacity = static_cast<uint32_t>(Ring.size());
+            if (Count == capacity)
+            {
+                std::vector<Job> ring(capacity * 2);
+                for (uint32_t i = 0; i < Count; i++)
+                    ring[i] = std::move(Ring[(Head + i) & (capacity - 1)]);
+                Ring.swap(ring);
+                Head = 0;
+            }
+            Ring[(Head + Count++) & (Ring.size() - 1)] = std::move(job);
+        }
+
+        void PopBack(Job& outJob)
+        {
+            outJob = std::move(Ring[(Head + --Count) & (Ring.size() - 1)]);
+        }
+
+        void PopFront(Job& outJob)
+        {
+            outJob = std::move(Ring[Head]);
+            Head = (Head + 1) & static_cast<uint32_t>(Ring.size() - 1);
+            Count--;
+        }
+
+        // Takes the most recent job tied to counter, the jobs queued after it move down to close the gap
+        bool PopCounter(const JobCounter* counter, Job& outJob)
+        {
+            const auto mask = static_cast<uint32_t>(Ring.size() - 1);
+            for (uint32_t i = Count; i-- > 0;)
+            {
+                if (Ring[(Head + i) & mask].Counter != counter)
+                    continue;
+
+                outJob = std::move(Ring[(Head + i) & mask]);
+                for (uint32_t j = i + 1; j < Count; j++)
+                    Ring[(Head + j - 1) & mask] = std::move(Ring[(Head + j) & mask]);
+                Count--;
+                return true;
+            }
+            return false;
+        }
+    };
+
+    struct JobSystemData
+    {
+        std::vector<std::thread> Workers;
+        // One queue per worker, plus a last one shared by the threads outside the pool (main thread)
+        std::vector<std::unique_ptr<JobQueue>> Queues;
+        // Background jobs, taken oldest first by pool threads only. Outlives Initialize and Shutdown.
+        JobQueue Background;
+        // Started instead of workers on a single core
+        std::thread BackgroundThread;
+
+        // Jobs sitting in the queues, background included, can briefly go negative as it is updated after the queue
+        std::atomic<int32_t> QueuedJobs{ 0 };
+        std::mutex SleepMutex;
+        std::condition_variable WakeCondition;
+        bool Stop = false;
+    };
+
+    JobSystemData s_Data;
+
+    constexpr uint32_t ExternalQueue = UINT32_MAX;
+    thread_local uint32_t t_QueueIndex = ExternalQueue;
+
+    uint32_t GetQueueIndex()
+    {
+        return t_QueueIndex == ExternalQueue ? static_cast<uint32_t>(s_Data.Queues.size() - 1) : t_QueueIndex;
+    }
+
+    bool HasThreads()
+    {
+        return !s_Data.Workers.empty() || s_Data.BackgroundThread.joinable();
+    }
+
+    void Push(JobQueue& queue, Job job)
+    {
+        {
+            std::lock_guard<std::mutex> lock(queue.Mutex);
+            queue.PushBack(std::move(job));
+        }
+        {
+            // Under the sleep mutex so that a worker about to sleep cannot miss the wake up
+            std::lock_guard<std::mutex> lock(s_Data.SleepMutex);
+            s_Data.QueuedJobs.fetch_add(1, std::memory_order_relaxed);
+        }
+        s_Data.WakeCondition.notify_one();
+    }
+
+    bool TryPop(const uint32_t queueIndex, Job& outJob)
+    {
+        // Own queue first, most recent job
+        {
+            JobQueue& queue = *s_Data.Queues[queueIndex];
+            std::lock_guard<std::mutex> lock(queue.Mutex);
+            if (queue.Count > 0)
+            {
+                queue.PopBack(outJob);
+                s_Data.QueuedJobs.fetch_sub(1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+
+        // Then steal the oldest job of another queue, starting with the next one so that thieves spread out
+        const auto queueCount = static_cast<uint32_t>(s_Data.Queues.size());
+        for (uint32_t i = 1; i < queueCount; i++)
+        {
+            JobQueue& queue = *s_Data.Queues[(queueIndex + i) % queueCount];
+            std::unique_lock<std::mutex> lock(queue.Mutex, std::try_to_lock);
+            if (!lock.owns_lock() || queue.Count == 0)
+                continue;
+
+            queue.PopFront(outJob);
+            s_Data.QueuedJobs.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+        return false;
+    }
+
+    bool TryPopBackground(Job& outJob)
+    {
+        std::lock_guard<std::mutex> lock(s_Data.Background.Mutex);
+        if (s_Data.Background.Count == 0)
+            return false;
+
+        s_Data.Background.PopFront(outJob);
+        s_Data.QueuedJobs.fetch_sub(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    // A job of the counter from the caller's queue, then from the others
+    bool TryPopCounter(const uint32_t queueIndex, const JobCounter* counter, Job& outJob)
+    {
+        const auto queueCount = static_cast<uint32_t>(s_Data.Queues.size());
+        for (uint32_t i = 0; i < queueCount; i++)
+        {
+            JobQueue& queue = *s_Data.Queues[(queueIndex + i) % queueCount];
+            std::unique_lock<std::mutex> lock(queue.Mutex, std::defer_lock);
+            if (i == 0)
+                lock.lock();
+            else if (!lock.try_lock())
+                continue;
+
+            if (queue.PopCounter(counter, outJob))
+            {
+                s_Data.QueuedJobs.fetch_sub(1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+
+        if (HasThreads())
+            return false;
+
+        std::lock_guard<std::mutex> lock(s_Data.Background.Mutex);
+        if (!s_Data.Background.PopCounter(counter, outJob))
+            return false;
+        s_Data.QueuedJobs.fetch_sub(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    // Sleeps until a job is queued, false once the pool stops with nothing left to run
+    bool WaitForJobs()
+    {
+        std::unique_lock<std::mutex> lock(s_Data.SleepMutex);
+        s_Data.WakeCondition.wait(lock, []() { return s_Data.Stop || s_Data.QueuedJobs.load(std::memory_order_relaxed) > 0; });
+        return !s_Data.Stop || s_Data.QueuedJobs.load(std::memory_order_relaxed) > 0;
+    }
+}
+
+void JobSystem::Initialize(uint32_t workerCount /* = 0 */)
+{
+    Shutdown();
+
+    if (workerCount == 0)
+        workerCount = std::max(1u, std::thread::hardware_concurrency()) - 1;
+
+    s_Data.Stop = false;
+    for (uint32_t i = 0; i <= workerCount; i++)
+        s_Data.Queues.push_back(std::make_unique<JobQueue>());
+    for (uint32_t i = 0; i < workerCount; i++)
+        s_Data.Workers.emplace_back(&JobSystem::WorkerMain, i);
+    if (workerCount == 0)
+        s_Data.BackgroundThread = std::thread(&JobSystem::BackgroundMain);
+}
+
+void JobSystem::Shutdown()
+{
+    {
+        std::lock_guard<std::mutex> lock(s_Data.SleepMutex);
+        s_Data.Stop = true;
+    }
+    s_Data.WakeCondition.notify_all();
+
+    for (std::thread& worker : s_Data.Workers)
+        worker.join();
+    s_Data.Workers.clear();
+    if (s_Data.BackgroundThread.joinable())
+        s_Data.BackgroundThread.join();
+
+    // Jobs queued by external threads are stolen by the workers before they exit, this only matters without workers
+    Job job;
+    while (!s_Data.Queues.empty() && TryPop(GetQueueIndex(), job))
+        Execute(job.Function, job.Counter);
+    s_Data.Queues.clear();
+}
+
+uint32_t JobSystem::GetWorkerCount()
+{
+    return static_cast<uint32_t>(s_Data.Workers.size());
+}
+
+void JobSystem::Run(Function function, JobCounter* counter /* = nullptr */)
+{
+    if (counter != nullptr)
+        counter->m_Pending.fetch_add(1, std::memory_order_relaxed);
+
+    if (s_Data.Workers.empty())
+        Execute(function, counter);
+    else
+        Push(*s_Data.Queues[GetQueueIndex()], { std::move(function), counter });
+}
+
+void JobSystem::RunBackground(Function function, JobCounter* counter /* = nullptr */)
+{
+    if (counter != nullptr)
+        counter->m_Pending.fetch_add(1, std::memory_order_relaxed);
+
+    Push(s_Data.Background, { std::move(function), counter });
+}
+
+void JobSystem::RunAfter(JobCounter& dependency, Function function, JobCounter* counter /* = nullptr */)
+{
+    {
+        std::lock_guard<std::mutex> lock(dependency.m_Mutex);
+        if (dependency.m_Pending.load(std::memory_order_acquire) != 0)
+        {
+            if (counter != nullptr)
+                counter->m_Pending.fetch_add(1, std::memory_order_relaxed);
+            dependency.m_Continuations.emplace_back(std::move(function), counter);
+            return;
+        }
+    }
+
+    Run(std::move(function), counter);
+}
+
+void JobSystem::Wait(JobCounter& counter)
+{
+    // Before Initialize or after Shutdown there are no queues: Run's jobs have all run inline or been drained by then
+    Job job;
+    while (!counter.IsDone())
+    {
+        if (TryPopCounter(s_Data.Queues.empty() ? 0 : GetQueueIndex(), &counter, job))
+            Execute(job.Function, job.Counter);
+        else
+            std::this_thread::yield();
+    }
+
+    // The thread that finished the last job may still hold the mutex
+    std::lock_guard<std::mutex> lock(counter.m_Mutex);
+}
+
+void JobSystem::ParallelFor(const uint32_t count, uint32_t batchSize, const RangeFunction& function)
+{
+    batchSize = std::max(1u, batchSize);
+    if (s_Data.Workers.empty() || count <= batchSize)
+    {
+        if (count > 0)
+            function(0, count);
+        return;
+    }
+
+    // The calling thread takes the first batch itself
+    JobCounter counter;
+    for (uint32_t begin = batchSize; begin < count; begin += batchSize)
+    {
+        const uint32_t end = std::min(count, begin + batchSize);
+        Run([&function, begin, end]() { function(begin, end); }, &counter);
+    }
+
+    function(0, batchSize);
+    Wait(counter);
+}
+
+void JobSystem::WorkerMain(const uint32_t queueIndex)
+{
+    t_QueueIndex = queueIndex;
+    Profiler::SetThreadName("Worker " + std::to_string(queueIndex));
+
+    // Background jobs only once there is nothing else left
+    Job job;
+    while (true)
+    {
+        if (TryPop(queueIndex, job) || TryPopBackground(job))
+        {
+            Execute(job.Function, job.Counter);
+            continue;
+        }
+
+        if (!WaitForJobs())
+            return;
+    }
+}
+
+void JobSystem::BackgroundMain()
+{
+    Profiler::SetThreadName("Background");
+
+    Job job;
+    while (true)
+    {
+        if (TryPopBackground(job))
+        {
+            Execute(job.Function, job.Counter);
+            continue;
+        }
+
+        if (!WaitForJobs())
+            return;
+    }
+}
+
+void JobSystem::Execute(Function& function, JobCounter* counter)
+{
+    {
+        PROFILE_SCOPE("Job");
+        function();
+    }
+    function = nullptr;
+
+    if (counter == nullptr)
+        return;
+
+    // Decremented under the counter's mutex: Wait takes it before returning, so the counter is not destroyed
+    // while this thread still uses it
+    std::vector<std::pair<Function, JobCounter*>> continuations;
+    {
+        std::lock_guard<std::mutex> lock(counter->m_Mutex);
+        if (counter->m_Pending.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            continuations.swap(counter->m_Continuations);
+    }
+
+    for (auto& continuation : continuations)
+    {
+        if (s_Data.Workers.empty())
+            Execute(continuation.first, continuation.second);
+        else
+            Push(*s_Data.Queues[GetQueueIndex()], { std::move(continuation.first), continuation.second });
+    }
+}
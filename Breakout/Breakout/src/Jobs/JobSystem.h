@@ -0,0 +1,76 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+// Number of unfinished jobs tied to it. A counter may be reused once it reached zero.
+class JobCounter
+{
+public:
+    JobCounter() = default;
+    JobCounter(const JobCounter& other) = delete;
+
+    bool IsDone() const { return m_Pending.load(std::memory_order_acquire) == 0; }
+private:
+    friend class JobSystem;
+
+    std::atomic<uint32_t> m_Pending{ 0 };
+
+    // Jobs started by RunAfter once the counter reaches zero
+    std::mutex m_Mutex;
+    std::vector<std::pair<std::function<void()>, JobCounter*>> m_Continuations;
+};
+
+// Pool of worker threads shared by the simulation and the asset loading. Every worker owns a deque: it pushes and
+// pops its own jobs at the back (most recent first, still in cache), idle workers steal from the front of the
+// others. Threads waiting on a counter run that counter's queued jobs in the meantime, so waiting inside a job never
+// deadlocks and a frame waiting on its batches never picks up unrelated work.
+//
+//     JobCounter counter;
+//     JobSystem::ParallelFor(bodyCount, 256, [&](uint32_t begin, uint32_t end) { ... });   // blocking
+//     JobSystem::Run([&]() { SimulateParticles(); }, &counter);
+//     JobSystem::RunAfter(counter, [&]() { CompactParticles(); }, &done);
+//     JobSystem::RunBackground([&]() { DecodeImage(); }, &decodes);
+//
+// Without workers (Initialize not called, or a single core) Run's jobs run inline on the submitting thread.
+// Background jobs (file I/O, image decoding) never do: they wait in their own queue for a pool thread with nothing
+// else to do, and a single core still gets one thread for them.
+class JobSystem
+{
+public:
+    using Function = std::function<void()>;
+    // [begin, end) of the range handed to a ParallelFor batch
+    using RangeFunction = std::function<void(uint32_t begin, uint32_t end)>;
+
+    // 0 workers = one per core but the calling thread's
+    static void Initialize(uint32_t workerCount = 0);
+    // Runs the jobs still queued, then joins the workers
+    static void Shutdown();
+
+    static uint32_t GetWorkerCount();
+
+    // counter, if any, is incremented now and decremented once the job has run
+    static void Run(Function function, JobCounter* counter = nullptr);
+    // Same, but the job is only queued once dependency reaches zero
+    static void RunAfter(JobCounter& dependency, Function function, JobCounter* counter = nullptr);
+    // Long running work, kept out of the queues that Wait and ParallelFor help with. Jobs queued before Initialize
+    // or after Shutdown wait for the next Initialize (or for a Wait on their counter, see below).
+    static void RunBackground(Function function, JobCounter* counter = nullptr);
+    // Returns once counter reaches zero, running the counter's own queued jobs meanwhile. Background jobs are left to
+    // the pool, unless it has no threads (before Initialize or after Shutdown, e.g. from static destructors): then
+    // nobody else would run them.
+    static void Wait(JobCounter& counter);
+
+    // Splits [0, count) into batches of batchSize and returns once all of them ran, the calling thread included
+    static void ParallelFor(uint32_t count, uint32_t batchSize, const RangeFunction& function);
+private:
+    static void WorkerMain(uint32_t queueIndex);
+    // The pool's only thread on a single core, runs background jobs alone
+    static void BackgroundMain();
+    // Runs the job, then releases its counter and queues the jobs that were waiting on it
+    static void Execute(Function& function, JobCounter* counter);
+};
@@ -0,0 +1,173 @@
+#include "BrickGrid.h"
+
+#include "../Memory/FrameArena.h"
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(__AVX__)
+    #include <immintrin.h>
+    #define BRICKGRID_AVX 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define BRICKGRID_SSE2 1
+#endif
+
+#ifdef _MSC_VER
+    #include <intrin.h>
+#endif
+
+namespace
+{
+    constexpr uint32_t BlockSize = 8;
+
+    uint32_t CountTrailingZeros(const uint32_t mask)
+    {
+#ifdef _MSC_VER
+        unsigned long index;
+        _BitScanForward(&index, mask);
+        return index;
+#else
+        return static_cast<uint32_t>(__builtin_ctz(mask));
+#endif
+    }
+
+    template<typename Allocator>
+    void AppendBits(uint32_t mask, const uint32_t firstBrick, std::vector<uint32_t, Allocator>& outBricks)
+    {
+        while (mask != 0)
+        {
+            outBricks.push_back(firstBrick + CountTrailingZeros(mask));
+            mask &= mask - 1;
+        }
+    }
+}
+
+BrickGrid::BrickGrid(const uint32_t columns, const uint32_t rows, const glm::vec2& origin, const glm::vec2& cellSize)
+    : m_Columns(columns), m_Rows(rows), m_Stride((columns + BlockSize - 1) / BlockSize * BlockSize), m_Origin(origin), m_CellSize(cellSize)
+{
+    const size_t count = static_cast<size_t>(m_Stride) * rows;
+    m_MinX.resize(count);
+    m_MinY.resize(count);
+    m_MaxX.resize(count);
+    m_MaxY.resize(count);
+    m_HitPoints.resize(count);
+    m_Alive.resize((count + 63) / 64);
+}
+
+void BrickGrid::SetBrick(const uint32_t column, const uint32_t row, const uint8_t hitPoints, const float padding /* = 0.0f */)
+{
+    const uint32_t brick = GetIndex(column, row);
+    const glm::vec2 cellMin = m_Origin + glm::vec2(column, row) * m_CellSize;
+
+    // Bricks never leave their cell, queries rely on it to skip the cells outside the query box
+    const float inset = std::clamp(padding, 0.0f, std::min(m_CellSize.x, m_CellSize.y) * 0.5f);
+    m_MinX[brick] = cellMin.x + inset;
+    m_MinY[brick] = cellMin.y + inset;
+    m_MaxX[brick] = cellMin.x + m_CellSize.x - inset;
+    m_MaxY[brick] = cellMin.y + m_CellSize.y - inset;
+
+    const bool wasAlive = IsAlive(brick);
+    m_HitPoints[brick] = hitPoints;
+    if (hitPoints > 0)
+        m_Alive[brick / 64] |= uint64_t(1) << (brick % 64);
+    else
+        m_Alive[brick / 64] &= ~(uint64_t(1) << (brick % 64));
+    m_AliveCount = m_AliveCount - wasAlive + (hitPoints > 0);
+}
+
+void BrickGrid::Clear()
+{
+    std::fill(m_HitPoints.begin(), m_HitPoints.end(), uint8_t(0));
+    std::fill(m_Alive.begin(), m_Alive.end(), uint64_t(0));
+    m_AliveCount = 0;
+}
+
+bool BrickGrid::Damage(const uint32_t brick, const uint8_t amount /* = 1 */)
+{
+    if (!IsAlive(brick))
+        return false;
+
+    m_HitPoints[brick] = m_HitPoints[brick] > amount ? static_cast<uint8_t>(m_HitPoints[brick] - amount) : uint8_t(0);
+    if (m_HitPoints[brick] > 0)
+        return false;
+
+    m_Alive[brick / 64] &= ~(uint64_t(1) << (brick % 64));
+    m_AliveCount--;
+    return true;
+}
+
+template<typename Allocator>
+void BrickGrid::QueryOverlaps(const glm::vec2& min, const glm::vec2& max, std::vector<uint32_t, Allocator>& outBricks) const
+{
+    // Cells covered by the box, clamped to the grid
+    const glm::vec2 first = glm::floor((min - m_Origin) / m_CellSize);
+    const glm::vec2 last = glm::floor((max - m_Origin) / m_CellSize);
+    if (last.x < 0.0f || last.y < 0.0f || first.x >= static_cast<float>(m_Columns) || first.y >= static_cast<float>(m_Rows))
+        return;
+
+    const uint32_t firstColumn = static_cast<uint32_t>(std::max(first.x, 0.0f));
+    const uint32_t lastColumn = static_cast<uint32_t>(std::min(last.x, static_cast<float>(m_Columns - 1)));
+    const uint32_t firstRow = static_cast<uint32_t>(std::max(first.y, 0.0f));
+    const uint32_t lastRow = static_cast<uint32_t>(std::min(last.y, static_cast<float>(m_Rows - 1)));
+
+    // Whole blocks of 8 are tested: lanes outside the covered columns are either padding (never alive) or bricks
+    // of neighbouring cells, for which the overlap test itself is exact
+    const uint32_t firstBlock = firstColumn / BlockSize * BlockSize;
+
+#if BRICKGRID_AVX
+    const __m256 queryMinX = _mm256_set1_ps(min.x), queryMinY = _mm256_set1_ps(min.y);
+    const __m256 queryMaxX = _mm256_set1_ps(max.x), queryMaxY = _mm256_set1_ps(max.y);
+#elif BRICKGRID_SSE2
+    const __m128 queryMinX = _mm_set1_ps(min.x), queryMinY = _mm_set1_ps(min.y);
+    const __m128 queryMaxX = _mm_set1_ps(max.x), queryMaxY = _mm_set1_ps(max.y);
+#endif
+
+    for (uint32_t row = firstRow; row <= lastRow; row++)
+    {
+        for (uint32_t column = firstBlock; column <= lastColumn; column += BlockSize)
+        {
+            const uint32_t brick = row * m_Stride + column;
+            const auto alive = static_cast<uint32_t>((m_Alive[brick / 64] >> (brick % 64)) & 0xff);
+            if (alive == 0)
+                continue;
+
+#if BRICKGRID_AVX
+            const __m256 overlap = _mm256_and_ps(
+                _mm256_and_ps(_mm256_cmp_ps(_mm256_loadu_ps(&m_MinX[brick]), queryMaxX, _CMP_LT_OQ), _mm256_cmp_ps(_mm256_loadu_ps(&m_MaxX[brick]), queryMinX, _CMP_GT_OQ)),
+                _mm256_and_ps(_mm256_cmp_ps(_mm256_loadu_ps(&m_MinY[brick]), queryMaxY, _CMP_LT_OQ), _mm256_cmp_ps(_mm256_loadu_ps(&m_MaxY[brick]), queryMinY, _CMP_GT_OQ)));
+            AppendBits(static_cast<uint32_t>(_mm256_movemask_ps(overlap)) & alive, brick, outBricks);
+#elif BRICKGRID_SSE2
+            uint32_t mask = 0;
+            for (uint32_t half = 0; half < BlockSize; half += 4)
+            {
+                const __m128 overlap = _mm_and_ps(
+                    _mm_and_ps(_mm_cmplt_ps(_mm_loadu_ps(&m_MinX[brick + half]), queryMaxX), _mm_cmpgt_ps(_mm_loadu_ps(&m_MaxX[brick + half]), queryMinX)),
+                    _mm_and_ps(_mm_cmplt_ps(_mm_loadu_ps(&m_MinY[brick + half]), queryMaxY), _mm_cmpgt_ps(_mm_loadu_ps(&m_MaxY[brick + half]), queryMinY)));
+                mask |= static_cast<uint32_t>(_mm_movemask_ps(overlap)) << half;
+            }
+            AppendBits(mask & alive, brick, outBricks);
+#else
+            uint32_t mask = 0;
+            for (uint32_t lane = 0; lane < BlockSize; lane++)
+            {
+                const uint32_t index = brick + lane;
+                const bool overlap = m_MinX[index] < max.x && m_MaxX[index] > min.x && m_MinY[index] < max.y && m_MaxY[index] > min.y;
+                mask |= static_cast<uint32_t>(overlap) << lane;
+            }
+            AppendBits(mask & alive, brick, outBricks);
+#endif
+        }
+    }
+}
+
+template<typename Allocator>
+void BrickGrid::QuerySwept(const glm::vec2& from, const glm::vec2& to, const float radius, std::vector<uint32_t, Allocator>& outBricks) const
+{
+    QueryOverlaps(glm::min(from, to) - radius, glm::max(from, to) + radius, outBricks);
+}
+
+template void BrickGrid::QueryOverlaps(const glm::vec2&, const glm::vec2&, std::vector<uint32_t>&) const;
+template void BrickGrid::QueryOverlaps(const glm::vec2&, const glm::vec2&, FrameVector<uint32_t>&) const;
+template void BrickGrid::QuerySwept(const glm::vec2&, const glm::vec2&, float, std::vector<uint32_t>&) const;
+template void BrickGrid::QuerySwept(const glm::vec2&, const glm::vec2&, float, FrameVector<uint32_t>&) const;
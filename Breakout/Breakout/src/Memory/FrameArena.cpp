@@ -0,0 +1,50 @@
+#include "FrameArena.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+
+namespace
+{
+    struct FrameArenaData
+    {
+        std::unique_ptr<LinearArena> Arenas[2];
+        uint32_t Current = 0;
+    };
+
+    FrameArenaData s_Data;
+}
+
+void FrameArena::Initialize(const size_t capacity)
+{
+    for (auto& arena : s_Data.Arenas)
+        arena = std::make_unique<LinearArena>(capacity);
+    s_Data.Current = 0;
+}
+
+void FrameArena::Shutdown()
+{
+    for (auto& arena : s_Data.Arenas)
+        arena.reset();
+}
+
+void FrameArena::BeginFrame()
+{
+    s_Data.Current ^= 1;
+    s_Data.Arenas[s_Data.Current]->Reset();
+}
+
+void* FrameArena::Allocate(const size_t size, const size_t alignment /* = alignof(std::max_align_t) */)
+{
+    return s_Data.Arenas[s_Data.Current]->Allocate(size, alignment);
+}
+
+LinearArena& FrameArena::GetCurrent()
+{
+    return *s_Data.Arenas[s_Data.Current];
+}
+
+size_t FrameArena::GetPeak()
+{
+    return std::max(s_Data.Arenas[0]->GetPeak(), s_Data.Arenas[1]->GetPeak());
+}
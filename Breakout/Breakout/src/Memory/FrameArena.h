@@ -0,0 +1,65 @@
+#pragma once
+
+#include "LinearArena.h"
+
+#include <cstddef>
+#include <new>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Transient memory of the game loop: collision lists, render commands, particle spawns. Two arenas take turns,
+// BeginFrame (top of the frame loop) resets the older one, so data written during a frame stays valid through the
+// next one (e.g. render commands built in frame N and consumed in frame N + 1).
+class FrameArena
+{
+public:
+    // capacity per arena, grown automatically after a frame that exceeded it
+    static void Initialize(size_t capacity);
+    static void Shutdown();
+
+    static void BeginFrame();
+
+    static void* Allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+
+    // Destructors are never run, only trivially destructible types
+    template<typename T, typename... Args>
+    static T* Create(Args&&... args)
+    {
+        static_assert(std::is_trivially_destructible_v<T>, "Frame allocations are never destroyed");
+        return new (Allocate(sizeof(T), alignof(T))) T{ std::forward<Args>(args)... };
+    }
+
+    // Arena of the current frame
+    static LinearArena& GetCurrent();
+    // Highest use of a single frame so far, to size the capacity
+    static size_t GetPeak();
+};
+
+// STL allocator drawing from the current frame's arena. A container using it must not be kept beyond the next frame.
+template<typename T>
+class FrameAllocator
+{
+public:
+    using value_type = T;
+
+    FrameAllocator() = default;
+
+    template<typename U>
+    FrameAllocator(const FrameAllocator<U>&)
+    {
+    }
+
+    T* allocate(const size_t count) { return static_cast<T*>(FrameArena::Allocate(count * sizeof(T), alignof(T))); }
+    void deallocate(T*, size_t) {}
+
+    template<typename U>
+    bool operator==(const FrameAllocator<U>&) const { return true; }
+    template<typename U>
+    bool operator!=(const FrameAllocator<U>&) const { return false; }
+};
+
+template<typename T>
+using FrameVector = std::vector<T, FrameAllocator<T>>;
+using FrameString = std::basic_string<char, std::char_traits<char>, FrameAllocator<char>>;
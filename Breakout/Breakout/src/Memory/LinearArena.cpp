@@ -0,0 +1,73 @@
+#include "LinearArena.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <new>
+
+LinearArena::LinearArena(const size_t capacity)
+    : m_Memory(std::make_unique<unsigned char[]>(capacity)), m_Capacity(capacity)
+{
+}
+
+LinearArena::~LinearArena()
+{
+    ReleaseOverflow();
+}
+
+void* LinearArena::Allocate(const size_t size, const size_t alignment /* = alignof(std::max_align_t) */)
+{
+    // Alignment is applied to the address, the buffer itself only has the default new alignment
+    const auto base = reinterpret_cast<uintptr_t>(m_Memory.get());
+    size_t offset = m_Offset.load(std::memory_order_relaxed);
+    while (true)
+    {
+        const uintptr_t address = (base + offset + alignment - 1) & ~static_cast<uintptr_t>(alignment - 1);
+        const size_t end = address - base + size;
+        if (end > m_Capacity)
+            return AllocateOverflow(size, alignment);
+
+        if (m_Offset.compare_exchange_weak(offset, end, std::memory_order_relaxed))
+            return reinterpret_cast<void*>(address);
+    }
+}
+
+void LinearArena::Reset()
+{
+    const size_t used = GetUsed();
+    m_Peak = std::max(m_Peak, used);
+
+    if (m_OverflowBytes > 0)
+    {
+        ReleaseOverflow();
+
+        // Half again what this cycle needed, alignment padding included
+        m_Capacity = used + used / 2;
+        m_Memory = std::make_unique<unsigned char[]>(m_Capacity);
+        std::cout << "| [WARNING] LinearArena: Capacity exceeded, grown to " << m_Capacity / 1024 << " KB" << '\n';
+    }
+
+    m_Offset.store(0, std::memory_order_relaxed);
+}
+
+size_t LinearArena::GetUsed() const
+{
+    return std::min(m_Offset.load(std::memory_order_relaxed), m_Capacity) + m_OverflowBytes;
+}
+
+void* LinearArena::AllocateOverflow(const size_t size, const size_t alignment)
+{
+    std::lock_guard<std::mutex> lock(m_OverflowMutex);
+    void* block = ::operator new(size, std::align_val_t(alignment));
+    m_Overflow.emplace_back(block, alignment);
+    m_OverflowBytes += size;
+    return block;
+}
+
+void LinearArena::ReleaseOverflow()
+{
+    for (const auto& [block, alignment] : m_Overflow)
+        ::operator delete(block, std::align_val_t(alignment));
+    m_Overflow.clear();
+    m_OverflowBytes = 0;
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+// Bump allocator: an allocation is an aligned pointer increment, nothing is freed on its own and Reset releases
+// everything at once. Allocate may be called from several threads (job system workers), Reset may not.
+// Requests past the capacity are served from the heap until the next Reset, which then grows the buffer so that the
+// same workload fits: a steady workload stops touching the heap after its first cycle.
+class LinearArena
+{
+public:
+    explicit LinearArena(size_t capacity);
+    LinearArena(const LinearArena& other) = delete;
+    ~LinearArena();
+
+    void* Allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+    void Reset();
+
+    size_t GetCapacity() const { return m_Capacity; }
+    // Bytes handed out since the last Reset, overflow included
+    size_t GetUsed() const;
+    // Highest GetUsed seen at a Reset
+    size_t GetPeak() const { return m_Peak; }
+private:
+    void* AllocateOverflow(size_t size, size_t alignment);
+    void ReleaseOverflow();
+private:
+    std::unique_ptr<unsigned char[]> m_Memory;
+    size_t m_Capacity;
+    std::atomic<size_t> m_Offset{ 0 };
+    size_t m_Peak = 0;
+
+    // Heap blocks (with their alignment) allocated once the buffer was full
+    std::mutex m_OverflowMutex;
+    std::vector<std::pair<void*, size_t>> m_Overflow;
+    size_t m_OverflowBytes = 0;
+};
+
+// STL allocator drawing from a given arena, deallocate is a no-op. Containers using it must not outlive the arena's
+// next Reset; growing one leaves its previous buffers behind in the arena, reserve up front when the size is known.
+template<typename T>
+class ArenaAllocator
+{
+public:
+    using value_type = T;
+
+    explicit ArenaAllocator(LinearArena& arena)
+        : m_Arena(&arena)
+    {
+    }
+
+    template<typename U>
+    ArenaAllocator(const ArenaAllocator<U>& other)
+        : m_Arena(other.GetArena())
+    {
+    }
+
+    T* allocate(const size_t count) { return static_cast<T*>(m_Arena->Allocate(count * sizeof(T), alignof(T))); }
+    void deallocate(T*, size_t) {}
+
+    LinearArena* GetArena() const { return m_Arena; }
+
+    template<typename U>
+    bool operator==(const ArenaAllocator<U>& other) const { return m_Arena == other.GetArena(); }
+    template<typename U>
+    bool operator!=(const ArenaAllocator<U>& other) const { return m_Arena != other.GetArena(); }
+private:
+    LinearArena* m_Arena;
+};
@@ -0,0 +1,152 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <utility>
+#include <vector>
+
+// Fixed-capacity pool for short-lived objects (balls, power-ups, particles). All the memory is allocated up front,
+// Create and Destroy are O(1) and never reach the system allocator: free slots are chained through their own storage.
+// Objects keep their address until destroyed. Handles carry the generation of their slot, so a handle to a
+// destroyed object stays invalid after the slot is reused. Live objects are listed densely for iteration.
+template<typename T>
+class ObjectPool
+{
+public:
+    static constexpr uint32_t InvalidIndex = UINT32_MAX;
+    static constexpr size_t CacheLineSize = 64;
+
+    struct Handle
+    {
+        uint32_t Index = InvalidIndex;
+        uint32_t Generation = 0;
+
+        bool operator==(const Handle& other) const { return Index == other.Index && Generation == other.Generation; }
+        bool operator!=(const Handle& other) const { return !(*this == other); }
+    };
+
+    explicit ObjectPool(const uint32_t capacity)
+        : m_Capacity(capacity), m_Generations(capacity, 0), m_LivePositions(capacity, InvalidIndex)
+    {
+        m_Slots = static_cast<Slot*>(::operator new(sizeof(Slot) * capacity, std::align_val_t(SlotAlignment)));
+        m_Live.reserve(capacity);
+        ChainFreeSlots();
+    }
+
+    ObjectPool(const ObjectPool& other) = delete;
+
+    ~ObjectPool()
+    {
+        Clear();
+        ::operator delete(m_Slots, std::align_val_t(SlotAlignment));
+    }
+
+    // Returns an invalid handle when the pool is full
+    template<typename... Args>
+    Handle Create(Args&&... args)
+    {
+        if (m_FirstFree == InvalidIndex)
+            return {};
+
+        const uint32_t index = m_FirstFree;
+        m_FirstFree = m_Slots[index].NextFree;
+
+        new (&m_Slots[index].Object) T{ std::forward<Args>(args)... };
+        m_LivePositions[index] = static_cast<uint32_t>(m_Live.size());
+        m_Live.push_back(index);
+        return { index, m_Generations[index] };
+    }
+
+    void Destroy(const Handle handle)
+    {
+        if (!IsValid(handle))
+            return;
+
+        const uint32_t index = handle.Index;
+        m_Slots[index].Object.~T();
+        m_Generations[index]++;
+
+        // The last live object takes the place of the destroyed one in the dense list
+        const uint32_t position = m_LivePositions[index];
+        const uint32_t last = m_Live.back();
+        m_Live[position] = last;
+        m_LivePositions[last] = position;
+        m_Live.pop_back();
+        m_LivePositions[index] = InvalidIndex;
+
+        m_Slots[index].NextFree = m_FirstFree;
+        m_FirstFree = index;
+    }
+
+    // Destroys every live object, outstanding handles become invalid
+    void Clear()
+    {
+        for (const uint32_t index : m_Live)
+        {
+            m_Slots[index].Object.~T();
+            m_Generations[index]++;
+            m_LivePositions[index] = InvalidIndex;
+        }
+        m_Live.clear();
+        ChainFreeSlots();
+    }
+
+    bool IsValid(const Handle handle) const
+    {
+        return handle.Index < m_Capacity && m_LivePositions[handle.Index] != InvalidIndex && m_Generations[handle.Index] == handle.Generation;
+    }
+
+    // nullptr when the object was destroyed
+    T* Get(const Handle handle) { return IsValid(handle) ? &m_Slots[handle.Index].Object : nullptr; }
+    const T* Get(const Handle handle) const { return IsValid(handle) ? &m_Slots[handle.Index].Object : nullptr; }
+
+    // Calls function(handle, object&) for every live object. The list is walked from its end, so the function may
+    // destroy the object it is given (a particle that expired), but no other.
+    template<typename Function>
+    void ForEach(Function&& function)
+    {
+        for (size_t i = m_Live.size(); i-- > 0;)
+        {
+            const uint32_t index = m_Live[i];
+            function(Handle{ index, m_Generations[index] }, m_Slots[index].Object);
+        }
+    }
+
+    uint32_t GetSize() const { return static_cast<uint32_t>(m_Live.size()); }
+    uint32_t GetCapacity() const { return m_Capacity; }
+    bool IsFull() const { return m_FirstFree == InvalidIndex; }
+private:
+    // A free slot's storage holds the index of the next free slot
+    union Slot
+    {
+        Slot() {}
+        ~Slot() {}
+
+        T Object;
+        uint32_t NextFree;
+    };
+
+    // The storage starts on a cache line; a T declared alignas(64) gets lines of its own
+    static constexpr size_t SlotAlignment = std::max(CacheLineSize, alignof(Slot));
+
+    // Lowest indices first, so a fresh pool fills from the start of its storage
+    void ChainFreeSlots()
+    {
+        for (uint32_t i = 0; i < m_Capacity; i++)
+            m_Slots[i].NextFree = i + 1 < m_Capacity ? i + 1 : InvalidIndex;
+        m_FirstFree = m_Capacity > 0 ? 0 : InvalidIndex;
+    }
+private:
+    Slot* m_Slots = nullptr;
+    uint32_t m_Capacity;
+    uint32_t m_FirstFree = InvalidIndex;
+
+    // Per slot: bumped when its object is destroyed, position in m_Live or InvalidIndex when free
+    std::vector<uint32_t> m_Generations;
+    std::vector<uint32_t> m_LivePositions;
+
+    // Indices of the live slots, packed
+    std::vector<uint32_t> m_Live;
+};
@@ -0,0 +1,196 @@
+#include "Collision.h"
+
+#include "../Level/BrickGrid.h"
+#include "../Memory/FrameArena.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+namespace
+{
+    // Impacts closer in time than this are simultaneous, e.g. a ball reaching the seam between two bricks
+    constexpr float SimultaneousTime = 1e-6f;
+
+    struct Candidate
+    {
+        Collision::SweepHit Hit;
+        Collision::Target Type;
+        uint32_t Index;
+    };
+
+    // Of two simultaneous impacts, a face beats a corner: a ball hitting the seam of a brick row must bounce off
+    // the row, not off the inner corner of one brick. Remaining ties go to bricks, then to the lowest index.
+    bool IsEarlier(const Candidate& candidate, const Candidate& best)
+    {
+        if (std::abs(candidate.Hit.Time - best.Hit.Time) > SimultaneousTime)
+            return candidate.Hit.Time < best.Hit.Time;
+
+        const bool candidateFace = candidate.Hit.Normal.x == 0.0f || candidate.Hit.Normal.y == 0.0f;
+        const bool bestFace = best.Hit.Normal.x == 0.0f || best.Hit.Normal.y == 0.0f;
+        if (candidateFace != bestFace)
+            return candidateFace;
+        if (candidate.Type != best.Type)
+            return candidate.Type == Collision::Target::Brick;
+        return candidate.Index < best.Index;
+    }
+}
+
+bool Collision::SweepCircleBox(const glm::vec2& center, const float radius, const glm::vec2& motion, const Box& box, SweepHit& outHit)
+{
+    // Already touching or overlapping (a ball resting where its last bounce left it): only a hit when moving deeper,
+    // along the direction of least penetration
+    const glm::vec2 closest = glm::clamp(center, box.Min, box.Max);
+    const glm::vec2 offset = center - closest;
+    const float distanceSquared = glm::dot(offset, offset);
+    if (distanceSquared <= radius * radius)
+    {
+        glm::vec2 normal;
+        if (distanceSquared > 0.0f)
+            normal = offset / std::sqrt(distanceSquared);
+        else
+        {
+            // Center inside the box: push out through the nearest face
+            const glm::vec2 toMin = center - box.Min, toMax = box.Max - center;
+            const float nearest = std::min(std::min(toMin.x, toMax.x), std::min(toMin.y, toMax.y));
+            if (nearest == toMin.x)
+                normal = { -1.0f, 0.0f };
+            else if (nearest == toMax.x)
+                normal = { 1.0f, 0.0f };
+            else if (nearest == toMin.y)
+                normal = { 0.0f, -1.0f };
+            else
+                normal = { 0.0f, 1.0f };
+        }
+
+        if (glm::dot(motion, normal) >= 0.0f)
+            return false;
+
+        outHit = { 0.0f, normal };
+        return true;
+    }
+
+    // Ray against the box inflated by the radius (slab test)
+    const glm::vec2 inflatedMin = box.Min - radius, inflatedMax = box.Max + radius;
+    float enterTime = -FLT_MAX, exitTime = FLT_MAX;
+    int enterAxis = -1;
+    for (int axis = 0; axis < 2; axis++)
+    {
+        if (motion[axis] == 0.0f)
+        {
+            if (center[axis] < inflatedMin[axis] || center[axis] > inflatedMax[axis])
+                return false;
+            continue;
+        }
+
+        float nearTime = (inflatedMin[axis] - center[axis]) / motion[axis];
+        float farTime = (inflatedMax[axis] - center[axis]) / motion[axis];
+        if (nearTime > farTime)
+            std::swap(nearTime, farTime);
+
+        if (nearTime > enterTime)
+        {
+            enterTime = nearTime;
+            enterAxis = axis;
+        }
+        exitTime = std::min(exitTime, farTime);
+    }
+
+    if (enterAxis < 0 || enterTime > exitTime || exitTime < 0.0f || enterTime > 1.0f)
+        return false;
+
+    // Started inside the inflated box without touching the circle: only possible in a corner square
+    enterTime = std::max(enterTime, 0.0f);
+
+    const glm::vec2 entry = center + motion * enterTime;
+    const bool beyondX = entry.x < box.Min.x || entry.x > box.Max.x;
+    const bool beyondY = entry.y < box.Min.y || entry.y > box.Max.y;
+    if (beyondX && beyondY)
+    {
+        // Entered the inflated box in a corner square: the actual boundary there is the arc around the corner
+        const glm::vec2 corner(entry.x < box.Min.x ? box.Min.x : box.Max.x, entry.y < box.Min.y ? box.Min.y : box.Max.y);
+        const glm::vec2 toCenter = center - corner;
+        const float a = glm::dot(motion, motion);
+        const float b = glm::dot(toCenter, motion);
+        const float c = glm::dot(toCenter, toCenter) - radius * radius;
+        const float discriminant = b * b - a * c;
+        if (discriminant < 0.0f)
+            return false;
+
+        const float time = (-b - std::sqrt(discriminant)) / a;
+        if (time < 0.0f || time > 1.0f)
+            return false;
+
+        outHit = { time, glm::normalize(center + motion * time - corner) };
+        return true;
+    }
+
+    glm::vec2 normal(0.0f);
+    normal[enterAxis] = motion[enterAxis] > 0.0f ? -1.0f : 1.0f;
+    if (glm::dot(motion, normal) >= 0.0f)
+        return false;
+
+    outHit = { enterTime, normal };
+    return true;
+}
+
+template<typename ImpactAllocator, typename BrickAllocator>
+void Collision::MoveBall(Ball& ball, const float deltaTime, BrickGrid& grid, const std::vector<Box>& boxes, std::vector<Impact, ImpactAllocator>& outImpacts,
+    std::vector<uint32_t, BrickAllocator>& scratchBricks)
+{
+    float elapsed = 0.0f;
+
+    for (uint32_t impacts = 0; impacts < MaxImpactsPerMove; impacts++)
+    {
+        const float remaining = deltaTime - elapsed;
+        if (remaining <= 0.0f)
+            return;
+
+        const glm::vec2 motion = ball.Velocity * remaining;
+
+        Candidate best{ { 2.0f, glm::vec2(0.0f) }, Target::Box, 0 };
+        bool hit = false;
+
+        scratchBricks.clear();
+        grid.QuerySwept(ball.Position, ball.Position + motion, ball.Radius, scratchBricks);
+        for (const uint32_t brick : scratchBricks)
+        {
+            Candidate candidate{ {}, Target::Brick, brick };
+            if (SweepCircleBox(ball.Position, ball.Radius, motion, { grid.GetMin(brick), grid.GetMax(brick) }, candidate.Hit) && IsEarlier(candidate, best))
+            {
+                best = candidate;
+                hit = true;
+            }
+        }
+
+        for (uint32_t i = 0; i < static_cast<uint32_t>(boxes.size()); i++)
+        {
+            Candidate candidate{ {}, Target::Box, i };
+            if (SweepCircleBox(ball.Position, ball.Radius, motion, boxes[i], candidate.Hit) && IsEarlier(candidate, best))
+            {
+                best = candidate;
+                hit = true;
+            }
+        }
+
+        if (!hit)
+        {
+            ball.Position += motion;
+            return;
+        }
+
+        // Stop at the impact and bounce, the rest of the tick is swept again from there
+        ball.Position += motion * best.Hit.Time;
+        elapsed += remaining * best.Hit.Time;
+
+        const float approach = glm::dot(ball.Velocity, best.Hit.Normal);
+        if (approach < 0.0f)
+            ball.Velocity -= 2.0f * approach * best.Hit.Normal;
+
+        const bool destroyed = best.Type == Target::Brick && grid.Damage(best.Index);
+        outImpacts.push_back({ best.Type, best.Index, elapsed, ball.Position, best.Hit.Normal, destroyed });
+    }
+}
+
+template void Collision::MoveBall(Ball&, float, BrickGrid&, const std::vector<Box>&, std::vector<Impact>&, std::vector<uint32_t>&);
+template void Collision::MoveBall(Ball&, float, BrickGrid&, const std::vector<Box>&, FrameVector<Impact>&, FrameVector<uint32_t>&);
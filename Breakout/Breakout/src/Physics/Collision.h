@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+class BrickGrid;
+
+// Continuous collision for balls: instead of testing overlaps at the end of a tick, every motion is swept against
+// the obstacles and the ball stops at the earliest time of impact, so no speed or tick length lets it tunnel through
+// a brick. Results only depend on the inputs (no hashing, fixed tie-breaking), replays stay deterministic.
+class Collision
+{
+public:
+    struct Box
+    {
+        glm::vec2 Min;
+        glm::vec2 Max;
+    };
+
+    struct Ball
+    {
+        glm::vec2 Position; // center
+        glm::vec2 Velocity; // units per second
+        float Radius;
+    };
+
+    struct SweepHit
+    {
+        float Time;       // fraction of the motion [0, 1] at first contact
+        glm::vec2 Normal; // unit contact normal, pointing from the box towards the ball
+    };
+
+    enum class Target : uint8_t
+    {
+        Brick,
+        Box
+    };
+
+    struct Impact
+    {
+        Target Type;
+        uint32_t Index;     // brick handle in the grid, or index into the boxes
+        float Time;         // seconds since the start of the move
+        glm::vec2 Position; // ball center at contact
+        glm::vec2 Normal;
+        bool Destroyed;     // the hit took the brick's last hit point
+    };
+
+    // A ball wedged between obstacles stops for the rest of the tick after this many impacts
+    static constexpr uint32_t MaxImpactsPerMove = 8;
+
+    // Circle moving by motion against a box (exact: the box inflated by the radius, with rounded corners).
+    // A circle already overlapping the box only hits it when moving further in, at time 0, so that a ball resting
+    // against a face after a bounce is free to leave.
+    static bool SweepCircleBox(const glm::vec2& center, float radius, const glm::vec2& motion, const Box& box, SweepHit& outHit);
+
+    // Moves the ball by deltaTime, resolving the impacts in time order: the ball stops at the earliest one,
+    // reflects off it and sweeps the rest of the tick again. Bricks are damaged as they are hit (destroyed ones
+    // still reflect the ball), boxes are static obstacles such as walls and the paddle. Appends to outImpacts.
+    // scratchBricks holds the broad phase results, kept by the caller so that moves do not allocate once it has grown.
+    // Both lists are heap (std::allocator) or frame arena (FrameAllocator) vectors.
+    template<typename ImpactAllocator, typename BrickAllocator>
+    static void MoveBall(Ball& ball, float deltaTime, BrickGrid& grid, const std::vector<Box>& boxes, std::vector<Impact, ImpactAllocator>& outImpacts,
+        std::vector<uint32_t, BrickAllocator>& scratchBricks);
+};
@@ -0,0 +1,372 @@
+#include "SpatialGrid.h"
+
+#include "../Memory/FrameArena.h"
+
+#include <algorithm>
+#include <cmath>
+
+SpatialGrid::SpatialGrid(const glm::vec2& fieldSize, const float cellSize)
+    : m_CellSize(cellSize), m_InverseCellSize(1.0f / cellSize)
+{
+    // Room for every cell of the play field at half load before the table has to grow
+    const auto fieldCells = static_cast<uint32_t>(std::ceil(fieldSize.x / cellSize) * std::ceil(fieldSize.y / cellSize));
+    uint32_t capacity = 16;
+    while (capacity < fieldCells * 2)
+        capacity *= 2;
+
+    m_Cells.resize(capacity);
+}
+
+uint32_t SpatialGrid::Insert(const glm::vec2& min, const glm::vec2& max, const uint32_t userData /* = 0 */)
+{
+    uint32_t body;
+    if (m_FirstFreeBody != InvalidBody)
+    {
+        body = m_FirstFreeBody;
+        m_FirstFreeBody = m_Bodies[body].NextFree;
+    }
+    else
+    {
+        body = static_cast<uint32_t>(m_Bodies.size());
+        m_Bodies.emplace_back();
+    }
+
+    Body& entry = m_Bodies[body];
+    entry = { min, max, GetCell(min), GetCell(max), userData, InvalidBody, m_Visit };
+    m_BodyCount++;
+
+    for (int y = entry.FirstCell.y; y <= entry.LastCell.y; y++)
+    {
+        for (int x = entry.FirstCell.x; x <= entry.LastCell.x; x++)
+            AddLink(x, y, body);
+    }
+
+    return body;
+}
+
+void SpatialGrid::Move(const uint32_t body, const glm::vec2& min, const glm::vec2& max)
+{
+    Body& entry = m_Bodies[body];
+    entry.Min = min;
+    entry.Max = max;
+
+    const glm::ivec2 firstCell = GetCell(min), lastCell = GetCell(max);
+    if (firstCell == entry.FirstCell && lastCell == entry.LastCell)
+        return;
+
+    // Only the cells entered or left are touched
+    for (int y = entry.FirstCell.y; y <= entry.LastCell.y; y++)
+    {
+        for (int x = entry.FirstCell.x; x <= entry.LastCell.x; x++)
+        {
+            if (x < firstCell.x || x > lastCell.x || y < firstCell.y || y > lastCell.y)
+                RemoveLink(x, y, body);
+        }
+    }
+
+    for (int y = firstCell.y; y <= lastCell.y; y++)
+    {
+        for (int x = firstCell.x; x <= lastCell.x; x++)
+        {
+            if (x < entry.FirstCell.x || x > entry.LastCell.x || y < entry.FirstCell.y || y > entry.LastCell.y)
+                AddLink(x, y, body);
+        }
+    }
+
+    entry.FirstCell = firstCell;
+    entry.LastCell = lastCell;
+}
+
+void SpatialGrid::Remove(const uint32_t body)
+{
+    Body& entry = m_Bodies[body];
+    for (int y = entry.FirstCell.y; y <= entry.LastCell.y; y++)
+    {
+        for (int x = entry.FirstCell.x; x <= entry.LastCell.x; x++)
+            RemoveLink(x, y, body);
+    }
+
+    entry.NextFree = m_FirstFreeBody;
+    m_FirstFreeBody = body;
+    m_BodyCount--;
+}
+
+void SpatialGrid::Clear()
+{
+    m_Bodies.clear();
+    m_FirstFreeBody = InvalidBody;
+    m_BodyCount = 0;
+
+    m_Links.clear();
+    m_FirstFreeLink = InvalidBody;
+
+    std::fill(m_Cells.begin(), m_Cells.end(), Cell());
+    m_CellCount = 0;
+}
+
+template<typename Allocator>
+void SpatialGrid::QueryAABB(const glm::vec2& min, const glm::vec2& max, std::vector<uint32_t, Allocator>& outBodies) const
+{
+    BeginQuery();
+
+    const glm::ivec2 firstCell = GetCell(min), lastCell = GetCell(max);
+    const size_t firstBody = outBodies.size();
+
+    // Boxes covering more cells than are occupied are cheaper to resolve by walking the table
+    const uint64_t coveredCells = static_cast<uint64_t>(lastCell.x - firstCell.x + 1) * static_cast<uint64_t>(lastCell.y - firstCell.y + 1);
+    if (coveredCells > m_CellCount)
+    {
+        for (const Cell& cell : m_Cells)
+        {
+            if (cell.Count == 0)
+                continue;
+
+            const auto x = static_cast<int32_t>(cell.Key >> 32), y = static_cast<int32_t>(cell.Key & 0xffffffff);
+            if (x >= firstCell.x && x <= lastCell.x && y >= firstCell.y && y <= lastCell.y)
+                CollectCell(x, y, outBodies);
+        }
+    }
+    else
+    {
+        for (int y = firstCell.y; y <= lastCell.y; y++)
+        {
+            for (int x = firstCell.x; x <= lastCell.x; x++)
+                CollectCell(x, y, outBodies);
+        }
+    }
+
+    // Sharing a cell is not enough, keep the bodies whose bounds overlap the box
+    const auto last = std::remove_if(outBodies.begin() + firstBody, outBodies.end(), [this, &min, &max](const uint32_t body)
+    {
+        const Body& entry = m_Bodies[body];
+        return entry.Min.x > max.x || entry.Max.x < min.x || entry.Min.y > max.y || entry.Max.y < min.y;
+    });
+    outBodies.erase(last, outBodies.end());
+}
+
+template<typename Allocator>
+void SpatialGrid::QueryRay(const glm::vec2& from, const glm::vec2& to, std::vector<uint32_t, Allocator>& outBodies) const
+{
+    BeginQuery();
+
+    m_RayCandidates.clear();
+    m_RayHits.clear();
+
+    // Cells crossed by the segment (Amanatides & Woo)
+    const glm::vec2 direction = to - from;
+    glm::ivec2 cell = GetCell(from);
+    const glm::ivec2 lastCell = GetCell(to);
+    const glm::ivec2 step(direction.x > 0.0f ? 1 : -1, direction.y > 0.0f ? 1 : -1);
+
+    glm::vec2 nextBoundary, boundaryStep;
+    for (int axis = 0; axis < 2; axis++)
+    {
+        if (direction[axis] == 0.0f)
+        {
+            nextBoundary[axis] = boundaryStep[axis] = INFINITY;
+            continue;
+        }
+
+        const float boundary = static_cast<float>(cell[axis] + (step[axis] > 0 ? 1 : 0)) * m_CellSize;
+        nextBoundary[axis] = (boundary - from[axis]) / direction[axis];
+        boundaryStep[axis] = m_CellSize / std::abs(direction[axis]);
+    }
+
+    const int cellCount = std::abs(lastCell.x - cell.x) + std::abs(lastCell.y - cell.y) + 1;
+    for (int i = 0; i < cellCount; i++)
+    {
+        CollectCell(cell.x, cell.y, m_RayCandidates);
+
+        const int axis = nextBoundary.x < nextBoundary.y ? 0 : 1;
+        cell[axis] += step[axis];
+        nextBoundary[axis] += boundaryStep[axis];
+    }
+
+    // Segment against the candidates' bounds, ordered by entry time
+    for (const uint32_t body : m_RayCandidates)
+    {
+        const Body& entry = m_Bodies[body];
+        float enterTime = 0.0f, exitTime = 1.0f;
+        for (int axis = 0; axis < 2 && enterTime <= exitTime; axis++)
+        {
+            if (direction[axis] == 0.0f)
+            {
+                if (from[axis] < entry.Min[axis] || from[axis] > entry.Max[axis])
+                    exitTime = -1.0f;
+                continue;
+            }
+
+            float nearTime = (entry.Min[axis] - from[axis]) / direction[axis];
+            float farTime = (entry.Max[axis] - from[axis]) / direction[axis];
+            if (nearTime > farTime)
+                std::swap(nearTime, farTime);
+            enterTime = std::max(enterTime, nearTime);
+            exitTime = std::min(exitTime, farTime);
+        }
+
+        if (enterTime <= exitTime)
+            m_RayHits.emplace_back(enterTime, body);
+    }
+
+    std::sort(m_RayHits.begin(), m_RayHits.end());
+    for (const auto& hit : m_RayHits)
+        outBodies.push_back(hit.second);
+}
+
+glm::ivec2 SpatialGrid::GetCell(const glm::vec2& position) const
+{
+    return { static_cast<int>(std::floor(position.x * m_InverseCellSize)), static_cast<int>(std::floor(position.y * m_InverseCellSize)) };
+}
+
+uint64_t SpatialGrid::GetKey(const int x, const int y)
+{
+    return (static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32) | static_cast<uint32_t>(y);
+}
+
+uint32_t SpatialGrid::GetHome(const uint64_t key) const
+{
+    // Fibonacci hashing, neighbouring cells spread over the table
+    return static_cast<uint32_t>((key * 0x9e3779b97f4a7c15ull) >> 32) & static_cast<uint32_t>(m_Cells.size() - 1);
+}
+
+uint32_t SpatialGrid::FindSlot(const uint64_t key) const
+{
+    const auto mask = static_cast<uint32_t>(m_Cells.size() - 1);
+    for (uint32_t slot = GetHome(key); m_Cells[slot].Count != 0; slot = (slot + 1) & mask)
+    {
+        if (m_Cells[slot].Key == key)
+            return slot;
+    }
+
+    return InvalidBody;
+}
+
+void SpatialGrid::AddLink(const int x, const int y, const uint32_t body)
+{
+    uint32_t link;
+    if (m_FirstFreeLink != InvalidBody)
+    {
+        link = m_FirstFreeLink;
+        m_FirstFreeLink = m_Links[link].Next;
+    }
+    else
+    {
+        link = static_cast<uint32_t>(m_Links.size());
+        m_Links.emplace_back();
+    }
+
+    const uint64_t key = GetKey(x, y);
+    uint32_t slot = FindSlot(key);
+    if (slot == InvalidBody)
+    {
+        if ((m_CellCount + 1) * 2 > m_Cells.size())
+            Rehash(static_cast<uint32_t>(m_Cells.size() * 2));
+
+        const auto mask = static_cast<uint32_t>(m_Cells.size() - 1);
+        slot = GetHome(key);
+        while (m_Cells[slot].Count != 0)
+            slot = (slot + 1) & mask;
+
+        m_Cells[slot] = { key, InvalidBody, 0 };
+        m_CellCount++;
+    }
+
+    Cell& cell = m_Cells[slot];
+    m_Links[link] = { body, cell.FirstLink };
+    cell.FirstLink = link;
+    cell.Count++;
+}
+
+void SpatialGrid::RemoveLink(const int x, const int y, const uint32_t body)
+{
+    const uint32_t slot = FindSlot(GetKey(x, y));
+    if (slot == InvalidBody)
+        return;
+
+    Cell& cell = m_Cells[slot];
+    for (uint32_t* link = &cell.FirstLink; *link != InvalidBody; link = &m_Links[*link].Next)
+    {
+        if (m_Links[*link].Body != body)
+            continue;
+
+        const uint32_t removed = *link;
+        *link = m_Links[removed].Next;
+        m_Links[removed].Next = m_FirstFreeLink;
+        m_FirstFreeLink = removed;
+
+        if (--cell.Count == 0)
+            EraseSlot(slot);
+        return;
+    }
+}
+
+void SpatialGrid::EraseSlot(uint32_t slot)
+{
+    // Backward shift: pull later entries of the probe sequence into the hole so that lookups never stop early
+    const auto mask = static_cast<uint32_t>(m_Cells.size() - 1);
+    for (uint32_t next = (slot + 1) & mask; m_Cells[next].Count != 0; next = (next + 1) & mask)
+    {
+        const uint32_t home = GetHome(m_Cells[next].Key);
+        // Distance from home to the hole vs. to the entry: the entry may move if its home is not past the hole
+        if (((slot - home) & mask) < ((next - home) & mask))
+        {
+            m_Cells[slot] = m_Cells[next];
+            slot = next;
+        }
+    }
+
+    m_Cells[slot] = Cell();
+    m_CellCount--;
+}
+
+void SpatialGrid::Rehash(const uint32_t capacity)
+{
+    std::vector<Cell> cells(capacity);
+    std::swap(cells, m_Cells);
+
+    const uint32_t mask = capacity - 1;
+    for (const Cell& cell : cells)
+    {
+        if (cell.Count == 0)
+            continue;
+
+        uint32_t slot = GetHome(cell.Key);
+        while (m_Cells[slot].Count != 0)
+            slot = (slot + 1) & mask;
+        m_Cells[slot] = cell;
+    }
+}
+
+void SpatialGrid::BeginQuery() const
+{
+    if (++m_Visit == 0)
+    {
+        // Stamps wrapped around: forget every previous query
+        for (const Body& body : m_Bodies)
+            body.Visit = 0;
+        m_Visit = 1;
+    }
+}
+
+template<typename Allocator>
+void SpatialGrid::CollectCell(const int x, const int y, std::vector<uint32_t, Allocator>& outBodies) const
+{
+    const uint32_t slot = FindSlot(GetKey(x, y));
+    if (slot == InvalidBody)
+        return;
+
+    for (uint32_t link = m_Cells[slot].FirstLink; link != InvalidBody; link = m_Links[link].Next)
+    {
+        const Body& body = m_Bodies[m_Links[link].Body];
+        if (body.Visit != m_Visit)
+        {
+            body.Visit = m_Visit;
+            outBodies.push_back(m_Links[link].Body);
+        }
+    }
+}
+
+template void SpatialGrid::QueryAABB(const glm::vec2&, const glm::vec2&, std::vector<uint32_t>&) const;
+template void SpatialGrid::QueryAABB(const glm::vec2&, const glm::vec2&, FrameVector<uint32_t>&) const;
+template void SpatialGrid::QueryRay(const glm::vec2&, const glm::vec2&, std::vector<uint32_t>&) const;
+template void SpatialGrid::QueryRay(const glm::vec2&, const glm::vec2&, FrameVector<uint32_t>&) const;
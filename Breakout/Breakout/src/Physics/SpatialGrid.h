@@ -0,0 +1,102 @@
+#pragma once
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+// Broad phase for dynamic bodies (balls, falling power-ups, particles): each body is linked into every cell of a
+// uniform grid its bounds overlap, and queries only look at the bodies of the cells they cover.
+// Occupied cells live in a flat open-addressing table (linear probing, backward-shift deletion) sized from the play
+// field, cell membership in a pooled array of links; nothing is allocated per body once the pools have grown.
+// Bodies may leave the play field, their cells are simply hashed like any other.
+class SpatialGrid
+{
+public:
+    static constexpr uint32_t InvalidBody = UINT32_MAX;
+
+    SpatialGrid(const glm::vec2& fieldSize, float cellSize);
+
+    // Returns the body's handle, reused once the body is removed
+    uint32_t Insert(const glm::vec2& min, const glm::vec2& max, uint32_t userData = 0);
+    // Cheap while the body stays within the same cells
+    void Move(uint32_t body, const glm::vec2& min, const glm::vec2& max);
+    void Remove(uint32_t body);
+    void Clear();
+
+    // Appends the bodies overlapping [min, max], each once. Results go to a heap (std::allocator) or a frame arena
+    // (FrameAllocator) vector.
+    template<typename Allocator>
+    void QueryAABB(const glm::vec2& min, const glm::vec2& max, std::vector<uint32_t, Allocator>& outBodies) const;
+    // Appends the bodies whose bounds the segment crosses, nearest first. Cells are walked along the segment (DDA)
+    // instead of covering its bounding box, so long diagonal sweeps stay cheap.
+    template<typename Allocator>
+    void QueryRay(const glm::vec2& from, const glm::vec2& to, std::vector<uint32_t, Allocator>& outBodies) const;
+
+    uint32_t GetUserData(uint32_t body) const { return m_Bodies[body].UserData; }
+    glm::vec2 GetMin(uint32_t body) const { return m_Bodies[body].Min; }
+    glm::vec2 GetMax(uint32_t body) const { return m_Bodies[body].Max; }
+    uint32_t GetBodyCount() const { return m_BodyCount; }
+    uint32_t GetCellCount() const { return m_CellCount; }
+private:
+    struct Body
+    {
+        glm::vec2 Min, Max;
+        glm::ivec2 FirstCell, LastCell;
+        uint32_t UserData;
+        uint32_t NextFree;      // free list link once removed
+        mutable uint32_t Visit; // last query that reported the body
+    };
+
+    // One entry per (cell, body) pair, chained per cell
+    struct Link
+    {
+        uint32_t Body;
+        uint32_t Next;
+    };
+
+    // Table slot, empty when Count is 0: cells are removed as soon as their last body leaves
+    struct Cell
+    {
+        uint64_t Key;
+        uint32_t FirstLink;
+        uint32_t Count;
+    };
+private:
+    glm::ivec2 GetCell(const glm::vec2& position) const;
+    static uint64_t GetKey(int x, int y);
+    uint32_t GetHome(uint64_t key) const;
+
+    // Slot holding the cell, or InvalidBody
+    uint32_t FindSlot(uint64_t key) const;
+    void AddLink(int x, int y, uint32_t body);
+    void RemoveLink(int x, int y, uint32_t body);
+    void EraseSlot(uint32_t slot);
+    void Rehash(uint32_t capacity);
+
+    // New stamp for the bodies visited by a query
+    void BeginQuery() const;
+    // Appends the bodies of the cell the current query has not seen yet
+    template<typename Allocator>
+    void CollectCell(int x, int y, std::vector<uint32_t, Allocator>& outBodies) const;
+private:
+    float m_CellSize;
+    float m_InverseCellSize;
+
+    std::vector<Body> m_Bodies;
+    uint32_t m_FirstFreeBody = InvalidBody;
+    uint32_t m_BodyCount = 0;
+
+    std::vector<Link> m_Links;
+    uint32_t m_FirstFreeLink = InvalidBody;
+
+    std::vector<Cell> m_Cells; // power of two
+    uint32_t m_CellCount = 0;
+
+    mutable uint32_t m_Visit = 0;
+
+    // Scratch space of the ray queries
+    mutable std::vector<uint32_t> m_RayCandidates;
+    mutable std::vector<std::pair<float, uint32_t>> m_RayHits;
+};
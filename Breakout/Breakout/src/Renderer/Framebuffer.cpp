@@ -0,0 +1,39 @@
+#include "Framebuffer.h"
+
+#include "RendererAPI.h"
+
+#include <algorithm>
+
+Framebuffer::Framebuffer(const int width, const int height)
+    : m_Width(width), m_Height(height)
+{
+    m_ID = RendererAPI::Get().CreateFramebuffer(width, height);
+}
+
+Framebuffer::~Framebuffer()
+{
+    RendererAPI::Get().DeleteFramebuffer(m_ID);
+}
+
+void Framebuffer::Bind() const
+{
+    RendererAPI::Get().BindFramebuffer(m_ID);
+}
+
+void Framebuffer::Unbind() const
+{
+    RendererAPI::Get().BindFramebuffer(0);
+}
+
+void Framebuffer::ReadPixels(std::vector<unsigned char>& outPixels) const
+{
+    const size_t rowSize = static_cast<size_t>(m_Width) * 4;
+    outPixels.resize(rowSize * m_Height);
+
+    Bind();
+    RendererAPI::Get().ReadPixels(0, 0, m_Width, m_Height, outPixels.data());
+
+    // GL returns the bottom row first
+    for (int y = 0; y < m_Height / 2; y++)
+        std::swap_ranges(outPixels.begin() + y * rowSize, outPixels.begin() + (y + 1) * rowSize, outPixels.end() - (y + 1) * rowSize);
+}
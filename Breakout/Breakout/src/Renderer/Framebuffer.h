@@ -0,0 +1,26 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+// Offscreen render target (RGBA8 color + depth), used to render frames without presenting them
+class Framebuffer
+{
+public:
+    Framebuffer(int width, int height);
+    Framebuffer(const Framebuffer& other) = delete;
+    ~Framebuffer();
+
+    void Bind() const;
+    void Unbind() const;
+
+    // Reads back the color attachment as RGBA8, top row first
+    void ReadPixels(std::vector<unsigned char>& outPixels) const;
+
+    uint32_t GetID() const { return m_ID; }
+    int GetWidth() const { return m_Width; }
+    int GetHeight() const { return m_Height; }
+private:
+    uint32_t m_ID = 0;
+    int m_Width, m_Height;
+};
@@ -0,0 +1,118 @@
+#include "InstanceBuffer.h"
+
+#include "RendererAPI.h"
+
+#include <algorithm>
+
+namespace
+{
+    // Clean instances between two dirty ones are re-uploaded too when the gap is this small,
+    // one slightly larger buffer update is cheaper than two separate calls
+    constexpr uint32_t MaxMergeGap = 8;
+}
+
+InstanceBuffer::InstanceBuffer(const uint32_t capacity)
+    : m_Capacity(capacity)
+{
+    m_ID = RendererAPI::Get().CreateBuffer();
+    m_Instances.reserve(capacity);
+    m_Dirty.reserve(capacity);
+}
+
+InstanceBuffer::~InstanceBuffer()
+{
+    RendererAPI::Get().DeleteBuffer(m_ID);
+}
+
+uint32_t InstanceBuffer::Add(const Instance& instance)
+{
+    const auto index = static_cast<uint32_t>(m_Instances.size());
+    m_Instances.push_back(instance);
+    m_Dirty.push_back(false);
+
+    if (m_Instances.size() > m_Capacity)
+    {
+        m_Capacity = std::max(m_Capacity * 2, 64u);
+        m_Reallocate = true;
+    }
+
+    MarkDirty(index);
+    return index;
+}
+
+void InstanceBuffer::Set(const uint32_t index, const Instance& instance)
+{
+    m_Instances[index] = instance;
+    MarkDirty(index);
+}
+
+void InstanceBuffer::SetColor(const uint32_t index, const glm::vec4& color)
+{
+    m_Instances[index].Color = color;
+    MarkDirty(index);
+}
+
+void InstanceBuffer::Hide(const uint32_t index)
+{
+    m_Instances[index].Size = glm::vec2(0.0f);
+    MarkDirty(index);
+}
+
+void InstanceBuffer::Clear()
+{
+    m_Instances.clear();
+    m_DirtyIndices.clear();
+    m_Dirty.clear();
+}
+
+void InstanceBuffer::MarkDirty(const uint32_t index)
+{
+    if (m_Reallocate || m_Dirty[index])
+        return;
+
+    m_Dirty[index] = true;
+    m_DirtyIndices.push_back(index);
+}
+
+uint32_t InstanceBuffer::Upload()
+{
+    RendererAPI& api = RendererAPI::Get();
+    api.BindBuffer(BufferTarget::Vertex, m_ID);
+
+    // Buffer (re)allocation: everything has to go up anyway
+    if (m_Reallocate)
+    {
+        api.SetBufferData(BufferTarget::Vertex, m_Capacity * sizeof(Instance), nullptr, BufferUsage::Dynamic);
+        api.SetBufferSubData(BufferTarget::Vertex, 0, m_Instances.size() * sizeof(Instance), m_Instances.data());
+
+        m_Reallocate = false;
+        std::fill(m_Dirty.begin(), m_Dirty.end(), false);
+        m_DirtyIndices.clear();
+        return static_cast<uint32_t>(m_Instances.size() * sizeof(Instance));
+    }
+
+    if (m_DirtyIndices.empty())
+        return 0;
+
+    std::sort(m_DirtyIndices.begin(), m_DirtyIndices.end());
+
+    uint32_t uploaded = 0;
+    size_t i = 0;
+    while (i < m_DirtyIndices.size())
+    {
+        const uint32_t first = m_DirtyIndices[i];
+        uint32_t last = first;
+        while (++i < m_DirtyIndices.size() && m_DirtyIndices[i] - last <= MaxMergeGap)
+            last = m_DirtyIndices[i];
+
+        const uint32_t count = last - first + 1;
+        api.SetBufferSubData(BufferTarget::Vertex, first * sizeof(Instance), count * sizeof(Instance), &m_Instances[first]);
+        uploaded += count * static_cast<uint32_t>(sizeof(Instance));
+    }
+
+    for (const uint32_t index : m_DirtyIndices)
+        m_Dirty[index] = false;
+    m_DirtyIndices.clear();
+
+    return uploaded;
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+// Per-instance attribute buffer for Renderer::DrawInstanced.
+// Instances keep their index for their whole lifetime, and only the ones modified since the
+// previous draw are written back to the GPU (as coalesced sub-range updates).
+class InstanceBuffer
+{
+public:
+    struct Instance
+    {
+        glm::vec2 Position; // top-left corner
+        glm::vec2 Size;
+        glm::vec4 Color;
+        glm::vec4 UVRect = glm::vec4(0.0f, 0.0f, 1.0f, 1.0f);
+    };
+
+    explicit InstanceBuffer(uint32_t capacity);
+    InstanceBuffer(const InstanceBuffer& other) = delete;
+    ~InstanceBuffer();
+
+    uint32_t Add(const Instance& instance);
+    void Set(uint32_t index, const Instance& instance);
+    void SetColor(uint32_t index, const glm::vec4& color);
+    // Hidden instances keep their slot but collapse to an empty quad
+    void Hide(uint32_t index);
+    void Clear();
+
+    const Instance& Get(uint32_t index) const { return m_Instances[index]; }
+    uint32_t GetCount() const { return static_cast<uint32_t>(m_Instances.size()); }
+    const unsigned int& GetID() const { return m_ID; }
+private:
+    void MarkDirty(uint32_t index);
+    // Writes pending changes to the GPU buffer, returns the number of bytes uploaded
+    uint32_t Upload();
+
+    friend class Renderer;
+private:
+    unsigned int m_ID = 0;
+    uint32_t m_Capacity = 0;
+    bool m_Reallocate = true;
+
+    std::vector<Instance> m_Instances;
+    std::vector<uint32_t> m_DirtyIndices;
+    std::vector<bool> m_Dirty;
+};
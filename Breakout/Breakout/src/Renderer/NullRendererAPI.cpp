@@ -0,0 +1,385 @@
+#include "NullRendererAPI.h"
+
+#include "TextureStreamer.h"
+
+#include <algorithm>
+#include <cstring>
+#include <regex>
+
+namespace
+{
+    uint32_t UniformTypeSize(const std::string& type)
+    {
+        if (type == "vec2" || type == "ivec2" || type == "uvec2" || type == "bvec2")
+            return 8;
+        if (type == "vec3" || type == "ivec3" || type == "uvec3" || type == "bvec3")
+            return 12;
+        if (type == "vec4" || type == "ivec4" || type == "uvec4" || type == "bvec4" || type == "mat2")
+            return 16;
+        if (type == "mat3")
+            return 36;
+        if (type == "mat4")
+            return 64;
+        // Scalars and samplers
+        return 4;
+    }
+
+    uint32_t UniformTypeSize(const UniformType type)
+    {
+        switch (type)
+        {
+            case UniformType::Vector2f: return 8;
+            case UniformType::Vector3f: return 12;
+            case UniformType::Vector4f: return 16;
+            case UniformType::Matrix4:  return 64;
+            default:                    return 4;
+        }
+    }
+
+    // Plain "uniform <type> <name>[<size>];" declarations, uniform blocks are followed by '{' and never match
+    void ParseUniforms(const char* source, std::vector<ProgramUniform>& uniforms)
+    {
+        if (source == nullptr)
+            return;
+
+        static const std::regex declaration(R"(\buniform\s+(?:(?:lowp|mediump|highp)\s+)?(\w+)\s+(\w+)\s*(?:\[\s*(\d+)\s*\])?\s*;)");
+
+        const std::string text(source);
+        for (auto it = std::sregex_iterator(text.begin(), text.end(), declaration); it != std::sregex_iterator(); ++it)
+        {
+            const std::smatch& match = *it;
+            const std::string name = match[2].str();
+            const bool declared = std::any_of(uniforms.begin(), uniforms.end(), [&name](const ProgramUniform& uniform) { return uniform.Name == name; });
+            if (declared)
+                continue;
+
+            // Array elements take one location each, like they do in OpenGL
+            const uint32_t count = match[3].matched ? static_cast<uint32_t>(std::stoul(match[3].str())) : 1;
+            const int location = uniforms.empty() ? 0 : uniforms.back().Location + static_cast<int>(uniforms.back().Count);
+            uniforms.push_back({ name, location, UniformTypeSize(match[1].str()) * count, count });
+        }
+    }
+}
+
+void NullRendererAPI::Initialize()
+{
+    Record(CommandType::Initialize);
+}
+
+void NullRendererAPI::SetViewport(int, int, int, int)
+{
+    Record(CommandType::SetViewport);
+}
+
+void NullRendererAPI::SetClearColor(const glm::vec4&)
+{
+    Record(CommandType::SetClearColor);
+}
+
+void NullRendererAPI::Clear()
+{
+    Record(CommandType::Clear);
+}
+
+void NullRendererAPI::Finish()
+{
+    Record(CommandType::Finish);
+}
+
+uint32_t NullRendererAPI::CreateBuffer()
+{
+    const uint32_t buffer = m_NextObject++;
+    Record(CommandType::CreateBuffer, buffer);
+    return buffer;
+}
+
+void NullRendererAPI::DeleteBuffer(const uint32_t buffer)
+{
+    Record(CommandType::DeleteBuffer, buffer);
+}
+
+void NullRendererAPI::BindBuffer(const BufferTarget target, const uint32_t buffer)
+{
+    if (target == BufferTarget::PixelUnpack)
+        m_UnpackBuffer = buffer;
+    Record(CommandType::BindBuffer, buffer);
+}
+
+void NullRendererAPI::BindBufferBase(BufferTarget, const uint32_t index, uint32_t)
+{
+    Record(CommandType::BindBufferBase, index);
+}
+
+void NullRendererAPI::SetBufferData(BufferTarget, const size_t size, const void* data, BufferUsage)
+{
+    Record(CommandType::SetBufferData, 0, data != nullptr ? size : 0);
+}
+
+void NullRendererAPI::SetBufferSubData(BufferTarget, size_t, const size_t size, const void*)
+{
+    Record(CommandType::SetBufferSubData, 0, size);
+}
+
+void* NullRendererAPI::MapBuffer(BufferTarget, const size_t size)
+{
+    if (m_Mapping.size() < size)
+        m_Mapping.resize(size);
+    m_MappedSize = size;
+
+    Record(CommandType::MapBuffer);
+    return m_Mapping.data();
+}
+
+void NullRendererAPI::UnmapBuffer(BufferTarget)
+{
+    Record(CommandType::UnmapBuffer, 0, m_MappedSize);
+    m_MappedSize = 0;
+}
+
+uint32_t NullRendererAPI::CreateVertexArray()
+{
+    const uint32_t vertexArray = m_NextObject++;
+    Record(CommandType::CreateVertexArray, vertexArray);
+    return vertexArray;
+}
+
+void NullRendererAPI::DeleteVertexArray(const uint32_t vertexArray)
+{
+    Record(CommandType::DeleteVertexArray, vertexArray);
+}
+
+void NullRendererAPI::BindVertexArray(const uint32_t vertexArray)
+{
+    Record(CommandType::BindVertexArray, vertexArray);
+}
+
+void NullRendererAPI::EnableVertexAttribute(const uint32_t index, uint32_t)
+{
+    Record(CommandType::EnableVertexAttribute, index);
+}
+
+void NullRendererAPI::SetVertexAttribute(const uint32_t index, int, uint32_t, size_t)
+{
+    Record(CommandType::SetVertexAttribute, index);
+}
+
+uint32_t NullRendererAPI::CreateTexture()
+{
+    const uint32_t texture = m_NextObject++;
+    Record(CommandType::CreateTexture, texture);
+    return texture;
+}
+
+void NullRendererAPI::DeleteTexture(const uint32_t texture)
+{
+    Record(CommandType::DeleteTexture, texture);
+}
+
+void NullRendererAPI::BindTexture(const uint32_t slot, uint32_t)
+{
+    Record(CommandType::BindTexture, slot);
+}
+
+void NullRendererAPI::SetTextureData(const int width, const int height, const TextureFormat format, const PixelType type, const void* data)
+{
+    Record(CommandType::SetTextureData, 0, TextureUploadSize(width, height, format, type, data));
+}
+
+void NullRendererAPI::SetTextureSubData(int, int, const int width, const int height, const TextureFormat format, const PixelType type, const void* data)
+{
+    Record(CommandType::SetTextureSubData, 0, TextureUploadSize(width, height, format, type, data));
+}
+
+void NullRendererAPI::SetTextureFilter(TextureFilter)
+{
+    Record(CommandType::SetTextureFilter);
+}
+
+void NullRendererAPI::SetTextureWrap(TextureWrap)
+{
+    Record(CommandType::SetTextureWrap);
+}
+
+void NullRendererAPI::SetUnpackAlignment(int)
+{
+    Record(CommandType::SetUnpackAlignment);
+}
+
+uint32_t NullRendererAPI::CreateProgram(const char* vertexSource, const char* fragmentSource, const char* geometrySource)
+{
+    const uint32_t program = m_NextObject++;
+
+    std::vector<ProgramUniform>& uniforms = m_ProgramUniforms[program];
+    ParseUniforms(vertexSource, uniforms);
+    ParseUniforms(fragmentSource, uniforms);
+    ParseUniforms(geometrySource, uniforms);
+
+    Record(CommandType::CreateProgram, program);
+    return program;
+}
+
+uint32_t NullRendererAPI::CreateFeedbackProgram(const char* vertexSource, const std::vector<const char*>&)
+{
+    const uint32_t program = m_NextObject++;
+    ParseUniforms(vertexSource, m_ProgramUniforms[program]);
+
+    Record(CommandType::CreateProgram, program);
+    return program;
+}
+
+void NullRendererAPI::DeleteProgram(const uint32_t program)
+{
+    m_ProgramUniforms.erase(program);
+    Record(CommandType::DeleteProgram, program);
+}
+
+void NullRendererAPI::UseProgram(const uint32_t program)
+{
+    Record(CommandType::UseProgram, program);
+}
+
+void NullRendererAPI::GetProgramUniforms(const uint32_t program, std::vector<ProgramUniform>& outUniforms)
+{
+    const auto it = m_ProgramUniforms.find(program);
+    if (it != m_ProgramUniforms.end())
+        outUniforms.insert(outUniforms.end(), it->second.begin(), it->second.end());
+}
+
+void NullRendererAPI::SetUniform(const int location, const UniformType type, const int count, const void*)
+{
+    Record(CommandType::SetUniform, static_cast<uint32_t>(location), static_cast<uint64_t>(UniformTypeSize(type)) * count);
+}
+
+uint32_t NullRendererAPI::CreateFramebuffer(int, int)
+{
+    const uint32_t framebuffer = m_NextObject++;
+    Record(CommandType::CreateFramebuffer, framebuffer);
+    return framebuffer;
+}
+
+void NullRendererAPI::DeleteFramebuffer(const uint32_t framebuffer)
+{
+    Record(CommandType::DeleteFramebuffer, framebuffer);
+}
+
+void NullRendererAPI::BindFramebuffer(const uint32_t framebuffer)
+{
+    Record(CommandType::BindFramebuffer, framebuffer);
+}
+
+void NullRendererAPI::ReadPixels(int, int, const int width, const int height, void* outPixels)
+{
+    // Nothing was rasterized
+    std::memset(outPixels, 0, static_cast<size_t>(width) * height * 4);
+    Record(CommandType::ReadPixels);
+}
+
+uint32_t NullRendererAPI::CreateQuery()
+{
+    const uint32_t query = m_NextObject++;
+    Record(CommandType::CreateQuery, query);
+    return query;
+}
+
+void NullRendererAPI::DeleteQuery(const uint32_t query)
+{
+    Record(CommandType::DeleteQuery, query);
+}
+
+void NullRendererAPI::BeginTimerQuery(const uint32_t query)
+{
+    Record(CommandType::BeginTimerQuery, query);
+}
+
+void NullRendererAPI::EndTimerQuery()
+{
+    Record(CommandType::EndTimerQuery);
+}
+
+bool NullRendererAPI::GetQueryResult(uint32_t, uint64_t& outNanoseconds)
+{
+    // Nothing ran on a GPU
+    outNanoseconds = 0;
+    return true;
+}
+
+void NullRendererAPI::BeginTransformFeedback(PrimitiveType)
+{
+    Record(CommandType::BeginTransformFeedback);
+}
+
+void NullRendererAPI::EndTransformFeedback()
+{
+    Record(CommandType::EndTransformFeedback);
+}
+
+void NullRendererAPI::SetRasterizerDiscard(bool)
+{
+    Record(CommandType::SetRasterizerDiscard);
+}
+
+void NullRendererAPI::DrawIndexed(PrimitiveType, const uint32_t indexCount)
+{
+    Record(CommandType::DrawIndexed, 0, indexCount);
+}
+
+void NullRendererAPI::DrawArraysInstanced(PrimitiveType, const uint32_t vertexCount, const uint32_t instanceCount)
+{
+    Record(CommandType::DrawArraysInstanced, 0, static_cast<uint64_t>(vertexCount) * instanceCount);
+}
+
+void NullRendererAPI::Reset()
+{
+    m_Commands.clear();
+    m_Counters = Counters();
+}
+
+void NullRendererAPI::Record(const CommandType type, const uint32_t object /* = 0 */, const uint64_t size /* = 0 */)
+{
+    m_Commands.push_back({ type, object, size });
+    m_Counters.Commands++;
+
+    switch (type)
+    {
+        case CommandType::DrawIndexed:
+        case CommandType::DrawArraysInstanced:
+            m_Counters.DrawCalls++;
+            break;
+        case CommandType::SetBufferData:
+        case CommandType::SetBufferSubData:
+        case CommandType::UnmapBuffer:
+        case CommandType::SetTextureData:
+        case CommandType::SetTextureSubData:
+        case CommandType::SetUniform:
+            m_Counters.BytesUploaded += size;
+            if (type == CommandType::SetUniform)
+                m_Counters.StateChanges++;
+            break;
+        case CommandType::SetViewport:
+        case CommandType::SetClearColor:
+        case CommandType::BindBuffer:
+        case CommandType::BindBufferBase:
+        case CommandType::BindVertexArray:
+        case CommandType::EnableVertexAttribute:
+        case CommandType::SetVertexAttribute:
+        case CommandType::BindTexture:
+        case CommandType::SetTextureFilter:
+        case CommandType::SetTextureWrap:
+        case CommandType::SetUnpackAlignment:
+        case CommandType::UseProgram:
+        case CommandType::BindFramebuffer:
+        case CommandType::SetRasterizerDiscard:
+            m_Counters.StateChanges++;
+            break;
+        default:
+            break;
+    }
+}
+
+uint64_t NullRendererAPI::TextureUploadSize(const int width, const int height, const TextureFormat format, const PixelType type, const void* data) const
+{
+    if (m_UnpackBuffer != 0 || data == nullptr)
+        return 0;
+
+    return static_cast<uint64_t>(width) * height * TextureStreamer::GetPixelSize(format, type);
+}
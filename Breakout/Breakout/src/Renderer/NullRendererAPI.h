@@ -0,0 +1,117 @@
+#pragma once
+
+#include "RendererAPI.h"
+
+#include <unordered_map>
+
+// Backend that executes nothing: every call is appended to a command buffer and tallied, so the cost of
+// building a frame (draw calls, state changes, bytes sent to the GPU) can be measured without a GPU or a context.
+// Handles are unique, mapped buffers point to scratch memory, and programs report the plain (non-block)
+// uniforms declared in their sources so that uniform uploads are recorded too.
+class NullRendererAPI : public RendererAPI
+{
+public:
+    enum class CommandType : uint8_t
+    {
+        Initialize, SetViewport, SetClearColor, Clear, Finish,
+        CreateBuffer, DeleteBuffer, BindBuffer, BindBufferBase, SetBufferData, SetBufferSubData, MapBuffer, UnmapBuffer,
+        CreateVertexArray, DeleteVertexArray, BindVertexArray, EnableVertexAttribute, SetVertexAttribute,
+        CreateTexture, DeleteTexture, BindTexture, SetTextureData, SetTextureSubData, SetTextureFilter, SetTextureWrap,
+        SetUnpackAlignment,
+        CreateProgram, DeleteProgram, UseProgram, SetUniform,
+        CreateFramebuffer, DeleteFramebuffer, BindFramebuffer, ReadPixels,
+        CreateQuery, DeleteQuery, BeginTimerQuery, EndTimerQuery,
+        BeginTransformFeedback, EndTransformFeedback, SetRasterizerDiscard,
+        DrawIndexed, DrawArraysInstanced
+    };
+
+    struct Command
+    {
+        CommandType Type;
+        uint32_t Object; // handle, binding index, texture slot or uniform location
+        uint64_t Size;   // bytes uploaded, or elements drawn for draws
+    };
+
+    struct Counters
+    {
+        uint32_t Commands = 0;
+        uint32_t DrawCalls = 0;
+        uint32_t StateChanges = 0; // binds, pipeline state, texture parameters and uniforms
+        uint64_t BytesUploaded = 0;
+    };
+
+    void Initialize() override;
+
+    void SetViewport(int x, int y, int width, int height) override;
+    void SetClearColor(const glm::vec4& color) override;
+    void Clear() override;
+    void Finish() override;
+
+    uint32_t CreateBuffer() override;
+    void DeleteBuffer(uint32_t buffer) override;
+    void BindBuffer(BufferTarget target, uint32_t buffer) override;
+    void BindBufferBase(BufferTarget target, uint32_t index, uint32_t buffer) override;
+    void SetBufferData(BufferTarget target, size_t size, const void* data, BufferUsage usage) override;
+    void SetBufferSubData(BufferTarget target, size_t offset, size_t size, const void* data) override;
+    void* MapBuffer(BufferTarget target, size_t size) override;
+    void UnmapBuffer(BufferTarget target) override;
+
+    uint32_t CreateVertexArray() override;
+    void DeleteVertexArray(uint32_t vertexArray) override;
+    void BindVertexArray(uint32_t vertexArray) override;
+    void EnableVertexAttribute(uint32_t index, uint32_t divisor = 0) override;
+    void SetVertexAttribute(uint32_t index, int components, uint32_t stride, size_t offset) override;
+
+    uint32_t CreateTexture() override;
+    void DeleteTexture(uint32_t texture) override;
+    void BindTexture(uint32_t slot, uint32_t texture) override;
+    void SetTextureData(int width, int height, TextureFormat format, PixelType type, const void* data) override;
+    void SetTextureSubData(int x, int y, int width, int height, TextureFormat format, PixelType type, const void* data) override;
+    void SetTextureFilter(TextureFilter filter) override;
+    void SetTextureWrap(TextureWrap wrap) override;
+    void SetUnpackAlignment(int alignment) override;
+
+    uint32_t CreateProgram(const char* vertexSource, const char* fragmentSource, const char* geometrySource) override;
+    uint32_t CreateFeedbackProgram(const char* vertexSource, const std::vector<const char*>& varyings) override;
+    void DeleteProgram(uint32_t program) override;
+    void UseProgram(uint32_t program) override;
+    void GetProgramUniforms(uint32_t program, std::vector<ProgramUniform>& outUniforms) override;
+    void SetUniform(int location, UniformType type, int count, const void* data) override;
+
+    uint32_t CreateFramebuffer(int width, int height) override;
+    void DeleteFramebuffer(uint32_t framebuffer) override;
+    void BindFramebuffer(uint32_t framebuffer) override;
+    void ReadPixels(int x, int y, int width, int height, void* outPixels) override;
+
+    uint32_t CreateQuery() override;
+    void DeleteQuery(uint32_t query) override;
+    void BeginTimerQuery(uint32_t query) override;
+    void EndTimerQuery() override;
+    bool GetQueryResult(uint32_t query, uint64_t& outNanoseconds) override;
+
+    void BeginTransformFeedback(PrimitiveType primitive) override;
+    void EndTransformFeedback() override;
+    void SetRasterizerDiscard(bool enabled) override;
+
+    void DrawIndexed(PrimitiveType primitive, uint32_t indexCount) override;
+    void DrawArraysInstanced(PrimitiveType primitive, uint32_t vertexCount, uint32_t instanceCount) override;
+
+    // Everything recorded since the last Reset
+    const std::vector<Command>& GetCommands() const { return m_Commands; }
+    const Counters& GetCounters() const { return m_Counters; }
+    // Meant to be called once per frame, objects created so far stay alive
+    void Reset();
+private:
+    void Record(CommandType type, uint32_t object = 0, uint64_t size = 0);
+    // Uploads sourced from a bound pixel unpack buffer were already counted when the buffer was written
+    uint64_t TextureUploadSize(int width, int height, TextureFormat format, PixelType type, const void* data) const;
+private:
+    std::vector<Command> m_Commands;
+    Counters m_Counters;
+
+    uint32_t m_NextObject = 1;
+    uint32_t m_UnpackBuffer = 0;
+    std::vector<unsigned char> m_Mapping;
+    size_t m_MappedSize = 0;
+    std::unordered_map<uint32_t, std::vector<ProgramUniform>> m_ProgramUniforms;
+};
@@ -0,0 +1,599 @@
+#include "OpenGLRendererAPI.h"
+
+#include "ShaderCache.h"
+#include "UniformBuffer.h"
+
+#include <glad/glad.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+
+namespace
+{
+    GLenum ToGL(const BufferTarget target)
+    {
+        switch (target)
+        {
+            case BufferTarget::Index:             return GL_ELEMENT_ARRAY_BUFFER;
+            case BufferTarget::Uniform:           return GL_UNIFORM_BUFFER;
+            case BufferTarget::PixelUnpack:       return GL_PIXEL_UNPACK_BUFFER;
+            case BufferTarget::TransformFeedback: return GL_TRANSFORM_FEEDBACK_BUFFER;
+            default:                              return GL_ARRAY_BUFFER;
+        }
+    }
+
+    GLenum ToGL(const BufferUsage usage)
+    {
+        switch (usage)
+        {
+            case BufferUsage::Static: return GL_STATIC_DRAW;
+            case BufferUsage::Stream: return GL_STREAM_DRAW;
+            default:                  return GL_DYNAMIC_DRAW;
+        }
+    }
+
+    GLenum ToGL(const PrimitiveType primitive)
+    {
+        switch (primitive)
+        {
+            case PrimitiveType::TriangleStrip: return GL_TRIANGLE_STRIP;
+            case PrimitiveType::Points:        return GL_POINTS;
+            default:                           return GL_TRIANGLES;
+        }
+    }
+
+    GLenum ToGL(const TextureFormat format)
+    {
+        switch (format)
+        {
+            case TextureFormat::Red: return GL_RED;
+            case TextureFormat::RG:  return GL_RG;
+            case TextureFormat::RGB: return GL_RGB;
+            default:                 return GL_RGBA;
+        }
+    }
+
+    GLenum ToGL(const PixelType type)
+    {
+        switch (type)
+        {
+            case PixelType::UnsignedShort: return GL_UNSIGNED_SHORT;
+            case PixelType::HalfFloat:     return GL_HALF_FLOAT;
+            case PixelType::Float:         return GL_FLOAT;
+            default:                       return GL_UNSIGNED_BYTE;
+        }
+    }
+
+    // Sized storage matching the uploaded channels: 8-bit normalized for bytes, 16 and 32-bit float otherwise
+    GLint ToGLInternalFormat(const TextureFormat format, const PixelType type)
+    {
+        static constexpr GLint formats[3][4] =
+        {
+            { GL_R8,   GL_RG8,   GL_RGB8,   GL_RGBA8 },
+            { GL_R16F, GL_RG16F, GL_RGB16F, GL_RGBA16F },
+            { GL_R32F, GL_RG32F, GL_RGB32F, GL_RGBA32F }
+        };
+
+        const size_t precision = type == PixelType::Float ? 2 : (type == PixelType::UnsignedByte ? 0 : 1);
+        return formats[precision][static_cast<size_t>(format)];
+    }
+
+    uint32_t UniformTypeSize(const unsigned int type)
+    {
+        switch (type)
+        {
+            case GL_FLOAT_VEC2: case GL_INT_VEC2: case GL_UNSIGNED_INT_VEC2: case GL_BOOL_VEC2:
+                return 8;
+            case GL_FLOAT_VEC3: case GL_INT_VEC3: case GL_UNSIGNED_INT_VEC3: case GL_BOOL_VEC3:
+                return 12;
+            case GL_FLOAT_VEC4: case GL_INT_VEC4: case GL_UNSIGNED_INT_VEC4: case GL_BOOL_VEC4: case GL_FLOAT_MAT2:
+                return 16;
+            case GL_FLOAT_MAT2x3: case GL_FLOAT_MAT3x2:
+                return 24;
+            case GL_FLOAT_MAT2x4: case GL_FLOAT_MAT4x2:
+                return 32;
+            case GL_FLOAT_MAT3:
+                return 36;
+            case GL_FLOAT_MAT3x4: case GL_FLOAT_MAT4x3:
+                return 48;
+            case GL_FLOAT_MAT4:
+                return 64;
+            default:
+                // Scalars and samplers
+                return 4;
+        }
+    }
+}
+
+void OpenGLRendererAPI::Initialize()
+{
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+    glEnable(GL_DEPTH_TEST);
+    // Quads sharing the same depth are drawn in submission order
+    glDepthFunc(GL_LEQUAL);
+
+    // Particles are point sprites sized by their vertex shader
+    glEnable(GL_PROGRAM_POINT_SIZE);
+}
+
+void OpenGLRendererAPI::SetViewport(const int x, const int y, const int width, const int height)
+{
+    glViewport(x, y, width, height);
+}
+
+void OpenGLRendererAPI::SetClearColor(const glm::vec4& color)
+{
+    glClearColor(color.r, color.g, color.b, color.a);
+}
+
+void OpenGLRendererAPI::Clear()
+{
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+}
+
+void OpenGLRendererAPI::Finish()
+{
+    glFinish();
+}
+
+uint32_t OpenGLRendererAPI::CreateBuffer()
+{
+    unsigned int buffer = 0;
+    glGenBuffers(1, &buffer);
+    return buffer;
+}
+
+void OpenGLRendererAPI::DeleteBuffer(const uint32_t buffer)
+{
+    glDeleteBuffers(1, &buffer);
+}
+
+void OpenGLRendererAPI::BindBuffer(const BufferTarget target, const uint32_t buffer)
+{
+    glBindBuffer(ToGL(target), buffer);
+}
+
+void OpenGLRendererAPI::BindBufferBase(const BufferTarget target, const uint32_t index, const uint32_t buffer)
+{
+    glBindBufferBase(ToGL(target), index, buffer);
+}
+
+void OpenGLRendererAPI::SetBufferData(const BufferTarget target, const size_t size, const void* data, const BufferUsage usage)
+{
+    glBufferData(ToGL(target), static_cast<GLsizeiptr>(size), data, ToGL(usage));
+}
+
+void OpenGLRendererAPI::SetBufferSubData(const BufferTarget target, const size_t offset, const size_t size, const void* data)
+{
+    glBufferSubData(ToGL(target), static_cast<GLintptr>(offset), static_cast<GLsizeiptr>(size), data);
+}
+
+void* OpenGLRendererAPI::MapBuffer(const BufferTarget target, const size_t size)
+{
+    return glMapBufferRange(ToGL(target), 0, static_cast<GLsizeiptr>(size), GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+}
+
+void OpenGLRendererAPI::UnmapBuffer(const BufferTarget target)
+{
+    glUnmapBuffer(ToGL(target));
+}
+
+uint32_t OpenGLRendererAPI::CreateVertexArray()
+{
+    unsigned int vertexArray = 0;
+    glGenVertexArrays(1, &vertexArray);
+    return vertexArray;
+}
+
+void OpenGLRendererAPI::DeleteVertexArray(const uint32_t vertexArray)
+{
+    glDeleteVertexArrays(1, &vertexArray);
+}
+
+void OpenGLRendererAPI::BindVertexArray(const uint32_t vertexArray)
+{
+    glBindVertexArray(vertexArray);
+}
+
+void OpenGLRendererAPI::EnableVertexAttribute(const uint32_t index, const uint32_t divisor /* = 0 */)
+{
+    glEnableVertexAttribArray(index);
+    if (divisor != 0)
+        glVertexAttribDivisor(index, divisor);
+}
+
+void OpenGLRendererAPI::SetVertexAttribute(const uint32_t index, const int components, const uint32_t stride, const size_t offset)
+{
+    glVertexAttribPointer(index, components, GL_FLOAT, GL_FALSE, static_cast<GLsizei>(stride), reinterpret_cast<const void*>(offset));
+}
+
+uint32_t OpenGLRendererAPI::CreateTexture()
+{
+    unsigned int texture = 0;
+    glGenTextures(1, &texture);
+    return texture;
+}
+
+void OpenGLRendererAPI::DeleteTexture(const uint32_t texture)
+{
+    glDeleteTextures(1, &texture);
+}
+
+void OpenGLRendererAPI::BindTexture(const uint32_t slot, const uint32_t texture)
+{
+    glActiveTexture(GL_TEXTURE0 + slot);
+    glBindTexture(GL_TEXTURE_2D, texture);
+}
+
+void OpenGLRendererAPI::SetTextureData(const int width, const int height, const TextureFormat format, const PixelType type,
+                                       const void* data)
+{
+    glTexImage2D(GL_TEXTURE_2D, 0, ToGLInternalFormat(format, type), width, height, 0, ToGL(format), ToGL(type), data);
+}
+
+void OpenGLRendererAPI::SetTextureSubData(const int x, const int y, const int width, const int height, const TextureFormat format,
+                                          const PixelType type, const void* data)
+{
+    glTexSubImage2D(GL_TEXTURE_2D, 0, x, y, width, height, ToGL(format), ToGL(type), data);
+}
+
+void OpenGLRendererAPI::SetTextureFilter(const TextureFilter filter)
+{
+    const GLint value = filter == TextureFilter::Nearest ? GL_NEAREST : GL_LINEAR;
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, value);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, value);
+}
+
+void OpenGLRendererAPI::SetTextureWrap(const TextureWrap wrap)
+{
+    const GLint value = wrap == TextureWrap::ClampToEdge ? GL_CLAMP_TO_EDGE : GL_REPEAT;
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, value);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, value);
+}
+
+void OpenGLRendererAPI::SetUnpackAlignment(const int alignment)
+{
+    glPixelStorei(GL_UNPACK_ALIGNMENT, alignment);
+}
+
+uint32_t OpenGLRendererAPI::CreateProgram(const char* vertexSource, const char* fragmentSource, const char* geometrySource)
+{
+    const auto startTime = std::chrono::steady_clock::now();
+    const auto elapsedMilliseconds = [&startTime]()
+    {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+    };
+
+    // Try the program binary cache first, a hit skips compilation and linking altogether
+    const uint64_t cacheKey = ShaderCache::ComputeKey(vertexSource, fragmentSource, geometrySource);
+    const unsigned int program = glCreateProgram();
+    if (ShaderCache::Load(cacheKey, program))
+    {
+        ShaderCache::RecordLoad(elapsedMilliseconds());
+
+        BindUniformBlocks(program);
+        return program;
+    }
+
+    unsigned int geometryID = 0;
+
+    // vertex Shader
+    unsigned int vertexID = glCreateShader(GL_VERTEX_SHADER);
+    glShaderSource(vertexID, 1, &vertexSource, nullptr);
+    glCompileShader(vertexID);
+    CheckCompileErrors(vertexID, "VERTEX");
+
+    // fragment Shader
+    unsigned int fragmentID = glCreateShader(GL_FRAGMENT_SHADER);
+    glShaderSource(fragmentID, 1, &fragmentSource, nullptr);
+    glCompileShader(fragmentID);
+    CheckCompileErrors(fragmentID, "FRAGMENT");
+
+    // if geometry shader source code is given, also compile geometry shader
+    if (geometrySource != nullptr)
+    {
+        geometryID = glCreateShader(GL_GEOMETRY_SHADER);
+        glShaderSource(geometryID, 1, &geometrySource, nullptr);
+        glCompileShader(geometryID);
+        CheckCompileErrors(geometryID, "GEOMETRY");
+    }
+
+    // shader program (a program whose cached binary got rejected can still be linked from source)
+    glAttachShader(program, vertexID);
+    glAttachShader(program, fragmentID);
+
+    if (geometrySource != nullptr)
+        glAttachShader(program, geometryID);
+
+    ShaderCache::PrepareProgram(program);
+    glLinkProgram(program);
+    CheckCompileErrors(program, "PROGRAM");
+
+    // delete the shaders as they're linked into our program now and no longer necessary
+    glDeleteShader(vertexID);
+    glDeleteShader(fragmentID);
+
+    if (geometrySource != nullptr)
+        glDeleteShader(geometryID);
+
+    int linked = 0;
+    glGetProgramiv(program, GL_LINK_STATUS, &linked);
+    if (linked)
+        ShaderCache::Store(cacheKey, program);
+
+    ShaderCache::RecordCompile(elapsedMilliseconds());
+
+    BindUniformBlocks(program);
+    return program;
+}
+
+uint32_t OpenGLRendererAPI::CreateFeedbackProgram(const char* vertexSource, const std::vector<const char*>& varyings)
+{
+    const auto startTime = std::chrono::steady_clock::now();
+    const auto elapsedMilliseconds = [&startTime]()
+    {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+    };
+
+    // The captured outputs are part of the link, hence of the cache key
+    std::string varyingList;
+    for (const char* varying : varyings)
+        varyingList.append(varying).push_back('\n');
+
+    const uint64_t cacheKey = ShaderCache::ComputeKey(vertexSource, nullptr, nullptr, varyingList.c_str());
+    const unsigned int program = glCreateProgram();
+    if (ShaderCache::Load(cacheKey, program))
+    {
+        ShaderCache::RecordLoad(elapsedMilliseconds());
+
+        BindUniformBlocks(program);
+        return program;
+    }
+
+    unsigned int vertexID = glCreateShader(GL_VERTEX_SHADER);
+    glShaderSource(vertexID, 1, &vertexSource, nullptr);
+    glCompileShader(vertexID);
+    CheckCompileErrors(vertexID, "VERTEX");
+
+    // No fragment stage: the program only runs with the rasterizer discarded
+    glAttachShader(program, vertexID);
+    glTransformFeedbackVaryings(program, static_cast<GLsizei>(varyings.size()), varyings.data(), GL_INTERLEAVED_ATTRIBS);
+
+    ShaderCache::PrepareProgram(program);
+    glLinkProgram(program);
+    CheckCompileErrors(program, "PROGRAM");
+    glDeleteShader(vertexID);
+
+    int linked = 0;
+    glGetProgramiv(program, GL_LINK_STATUS, &linked);
+    if (linked)
+        ShaderCache::Store(cacheKey, program);
+
+    ShaderCache::RecordCompile(elapsedMilliseconds());
+
+    BindUniformBlocks(program);
+    return program;
+}
+
+void OpenGLRendererAPI::DeleteProgram(const uint32_t program)
+{
+    glDeleteProgram(program);
+}
+
+void OpenGLRendererAPI::UseProgram(const uint32_t program)
+{
+    glUseProgram(program);
+}
+
+void OpenGLRendererAPI::GetProgramUniforms(const uint32_t program, std::vector<ProgramUniform>& outUniforms)
+{
+    int uniformCount = 0, maxNameLength = 0;
+    glGetProgramiv(program, GL_ACTIVE_UNIFORMS, &uniformCount);
+    glGetProgramiv(program, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxNameLength);
+
+    std::vector<char> name(std::max(maxNameLength, 1));
+    for (int i = 0; i < uniformCount; i++)
+    {
+        int length = 0, size = 0;
+        unsigned int type = 0;
+        glGetActiveUniform(program, static_cast<unsigned int>(i), maxNameLength, &length, &size, &type, name.data());
+
+        // Uniforms living in a uniform block have no location
+        const int location = glGetUniformLocation(program, name.data());
+        if (location < 0)
+            continue;
+
+        outUniforms.push_back({ std::string(name.data(), length), location, UniformTypeSize(type) * static_cast<uint32_t>(size), static_cast<uint32_t>(size) });
+    }
+}
+
+void OpenGLRendererAPI::SetUniform(const int location, const UniformType type, const int count, const void* data)
+{
+    const auto* floats = static_cast<const float*>(data);
+    switch (type)
+    {
+        case UniformType::Float:
+            glUniform1fv(location, count, floats);
+            break;
+        case UniformType::Integer:
+            glUniform1iv(location, count, static_cast<const int*>(data));
+            break;
+        case UniformType::Vector2f:
+            glUniform2fv(location, count, floats);
+            break;
+        case UniformType::Vector3f:
+            glUniform3fv(location, count, floats);
+            break;
+        case UniformType::Vector4f:
+            glUniform4fv(location, count, floats);
+            break;
+        case UniformType::Matrix4:
+            glUniformMatrix4fv(location, count, GL_FALSE, floats);
+            break;
+    }
+}
+
+uint32_t OpenGLRendererAPI::CreateFramebuffer(const int width, const int height)
+{
+    FramebufferAttachments attachments{};
+    unsigned int framebuffer = 0;
+    glGenFramebuffers(1, &framebuffer);
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+
+    glGenRenderbuffers(1, &attachments.Color);
+    glBindRenderbuffer(GL_RENDERBUFFER, attachments.Color);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, width, height);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, attachments.Color);
+
+    glGenRenderbuffers(1, &attachments.Depth);
+    glBindRenderbuffer(GL_RENDERBUFFER, attachments.Depth);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, width, height);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, attachments.Depth);
+
+    if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+        std::cout << "| [ERROR] Renderer: Framebuffer " << width << "x" << height << " is incomplete" << '\n';
+
+    glBindRenderbuffer(GL_RENDERBUFFER, 0);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+    m_Framebuffers[framebuffer] = attachments;
+    return framebuffer;
+}
+
+void OpenGLRendererAPI::DeleteFramebuffer(const uint32_t framebuffer)
+{
+    const auto it = m_Framebuffers.find(framebuffer);
+    if (it != m_Framebuffers.end())
+    {
+        glDeleteRenderbuffers(1, &it->second.Color);
+        glDeleteRenderbuffers(1, &it->second.Depth);
+        m_Framebuffers.erase(it);
+    }
+
+    glDeleteFramebuffers(1, &framebuffer);
+}
+
+void OpenGLRendererAPI::BindFramebuffer(const uint32_t framebuffer)
+{
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+}
+
+void OpenGLRendererAPI::ReadPixels(const int x, const int y, const int width, const int height, void* outPixels)
+{
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glReadPixels(x, y, width, height, GL_RGBA, GL_UNSIGNED_BYTE, outPixels);
+    glPixelStorei(GL_PACK_ALIGNMENT, 4);
+}
+
+uint32_t OpenGLRendererAPI::CreateQuery()
+{
+    unsigned int query = 0;
+    glGenQueries(1, &query);
+    return query;
+}
+
+void OpenGLRendererAPI::DeleteQuery(const uint32_t query)
+{
+    glDeleteQueries(1, &query);
+}
+
+void OpenGLRendererAPI::BeginTimerQuery(const uint32_t query)
+{
+    glBeginQuery(GL_TIME_ELAPSED, query);
+}
+
+void OpenGLRendererAPI::EndTimerQuery()
+{
+    glEndQuery(GL_TIME_ELAPSED);
+}
+
+bool OpenGLRendererAPI::GetQueryResult(const uint32_t query, uint64_t& outNanoseconds)
+{
+    GLint available = GL_FALSE;
+    glGetQueryObjectiv(query, GL_QUERY_RESULT_AVAILABLE, &available);
+    if (available == GL_FALSE)
+        return false;
+
+    GLuint64 nanoseconds = 0;
+    glGetQueryObjectui64v(query, GL_QUERY_RESULT, &nanoseconds);
+    outNanoseconds = nanoseconds;
+    return true;
+}
+
+void OpenGLRendererAPI::BeginTransformFeedback(const PrimitiveType primitive)
+{
+    glBeginTransformFeedback(ToGL(primitive));
+}
+
+void OpenGLRendererAPI::EndTransformFeedback()
+{
+    glEndTransformFeedback();
+}
+
+void OpenGLRendererAPI::SetRasterizerDiscard(const bool enabled)
+{
+    if (enabled)
+        glEnable(GL_RASTERIZER_DISCARD);
+    else
+        glDisable(GL_RASTERIZER_DISCARD);
+}
+
+void OpenGLRendererAPI::DrawIndexed(const PrimitiveType primitive, const uint32_t indexCount)
+{
+    glDrawElements(ToGL(primitive), static_cast<GLsizei>(indexCount), GL_UNSIGNED_INT, nullptr);
+}
+
+void OpenGLRendererAPI::DrawArraysInstanced(const PrimitiveType primitive, const uint32_t vertexCount, const uint32_t instanceCount)
+{
+    glDrawArraysInstanced(ToGL(primitive), 0, static_cast<GLsizei>(vertexCount), static_cast<GLsizei>(instanceCount));
+}
+
+void OpenGLRendererAPI::BindUniformBlocks(const uint32_t program)
+{
+    int blockCount = 0;
+    glGetProgramiv(program, GL_ACTIVE_UNIFORM_BLOCKS, &blockCount);
+
+    char name[128];
+    for (int i = 0; i < blockCount; i++)
+    {
+        glGetActiveUniformBlockName(program, static_cast<unsigned int>(i), sizeof(name), nullptr, name);
+
+        const int binding = UniformBuffer::GetBlockBinding(name);
+        if (binding >= 0)
+            glUniformBlockBinding(program, static_cast<unsigned int>(i), static_cast<unsigned int>(binding));
+        else
+            std::cout << "| [WARNING] Shader: Uniform block '" << name << "' has no shared binding point" << '\n';
+    }
+}
+
+void OpenGLRendererAPI::CheckCompileErrors(const unsigned int id, const char* type)
+{
+    int success;
+    char infoLog[1024];
+    if (std::strcmp(type, "PROGRAM") != 0)
+    {
+        glGetShaderiv(id, GL_COMPILE_STATUS, &success);
+        if (!success)
+        {
+            glGetShaderInfoLog(id, 1024, nullptr, infoLog);
+            std::cout << "| [ERROR] Shader: Compile-time error: Type: " << type << '\n'
+                << infoLog << "\n -- --------------------------------------------------- -- "
+                << '\n';
+        }
+    }
+    else
+    {
+        glGetProgramiv(id, GL_LINK_STATUS, &success);
+        if (!success)
+        {
+            glGetProgramInfoLog(id, 1024, nullptr, infoLog);
+            std::cout << "| [ERROR] Shader: Link-time error: Type: " << type << '\n'
+                << infoLog << "\n -- --------------------------------------------------- -- "
+                << '\n';
+        }
+    }
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+#include "RendererAPI.h"
+
+#include <unordered_map>
+
+class OpenGLRendererAPI : public RendererAPI
+{
+public:
+    void Initialize() override;
+
+    void SetViewport(int x, int y, int width, int height) override;
+    void SetClearColor(const glm::vec4& color) override;
+    void Clear() override;
+    void Finish() override;
+
+    uint32_t CreateBuffer() override;
+    void DeleteBuffer(uint32_t buffer) override;
+    void BindBuffer(BufferTarget target, uint32_t buffer) override;
+    void BindBufferBase(BufferTarget target, uint32_t index, uint32_t buffer) override;
+    void SetBufferData(BufferTarget target, size_t size, const void* data, BufferUsage usage) override;
+    void SetBufferSubData(BufferTarget target, size_t offset, size_t size, const void* data) override;
+    void* MapBuffer(BufferTarget target, size_t size) override;
+    void UnmapBuffer(BufferTarget target) override;
+
+    uint32_t CreateVertexArray() override;
+    void DeleteVertexArray(uint32_t vertexArray) override;
+    void BindVertexArray(uint32_t vertexArray) override;
+    void EnableVertexAttribute(uint32_t index, uint32_t divisor = 0) override;
+    void SetVertexAttribute(uint32_t index, int components, uint32_t stride, size_t offset) override;
+
+    uint32_t CreateTexture() override;
+    void DeleteTexture(uint32_t texture) override;
+    void BindTexture(uint32_t slot, uint32_t texture) override;
+    void SetTextureData(int width, int height, TextureFormat format, PixelType type, const void* data) override;
+    void SetTextureSubData(int x, int y, int width, int height, TextureFormat format, PixelType type, const void* data) override;
+    void SetTextureFilter(TextureFilter filter) override;
+    void SetTextureWrap(TextureWrap wrap) override;
+    void SetUnpackAlignment(int alignment) override;
+
+    uint32_t CreateProgram(const char* vertexSource, const char* fragmentSource, const char* geometrySource) override;
+    uint32_t CreateFeedbackProgram(const char* vertexSource, const std::vector<const char*>& varyings) override;
+    void DeleteProgram(uint32_t program) override;
+    void UseProgram(uint32_t program) override;
+    void GetProgramUniforms(uint32_t program, std::vector<ProgramUniform>& outUniforms) override;
+    void SetUniform(int location, UniformType type, int count, const void* data) override;
+
+    uint32_t CreateFramebuffer(int width, int height) override;
+    void DeleteFramebuffer(uint32_t framebuffer) override;
+    void BindFramebuffer(uint32_t framebuffer) override;
+    void ReadPixels(int x, int y, int width, int height, void* outPixels) override;
+
+    uint32_t CreateQuery() override;
+    void DeleteQuery(uint32_t query) override;
+    void BeginTimerQuery(uint32_t query) override;
+    void EndTimerQuery() override;
+    bool GetQueryResult(uint32_t query, uint64_t& outNanoseconds) override;
+
+    void BeginTransformFeedback(PrimitiveType primitive) override;
+    void EndTransformFeedback() override;
+    void SetRasterizerDiscard(bool enabled) override;
+
+    void DrawIndexed(PrimitiveType primitive, uint32_t indexCount) override;
+    void DrawArraysInstanced(PrimitiveType primitive, uint32_t vertexCount, uint32_t instanceCount) override;
+private:
+    struct FramebufferAttachments
+    {
+        uint32_t Color;
+        uint32_t Depth;
+    };
+
+    std::unordered_map<uint32_t, FramebufferAttachments> m_Framebuffers;
+private:
+    static void BindUniformBlocks(uint32_t program);
+    static void CheckCompileErrors(unsigned int id, const char* type);
+};
@@ -0,0 +1,117 @@
+#include "ParticleSystem.h"
+
+#include "RendererAPI.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+
+namespace
+{
+    static_assert(sizeof(ParticleSystem::Particle) == 48, "Particle layout must match the transform feedback outputs");
+
+    // Particles a frame can emit before the pending list has to grow
+    constexpr uint32_t PendingReserve = 1024;
+
+    // xorshift32, mapped to [0, 1)
+    float NextRandom(uint32_t& state)
+    {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        return static_cast<float>(state >> 8) * (1.0f / 16777216.0f);
+    }
+}
+
+ParticleSystem::ParticleSystem(const uint32_t capacity)
+    : m_Capacity(capacity)
+{
+    RendererAPI& backend = RendererAPI::Get();
+
+    // Slots are only simulated once written, the initial contents never matter
+    constexpr auto stride = static_cast<uint32_t>(sizeof(Particle));
+    for (uint32_t i = 0; i < 2; i++)
+    {
+        m_VertexArrays[i] = backend.CreateVertexArray();
+        backend.BindVertexArray(m_VertexArrays[i]);
+
+        m_Buffers[i] = backend.CreateBuffer();
+        backend.BindBuffer(BufferTarget::Vertex, m_Buffers[i]);
+        backend.SetBufferData(BufferTarget::Vertex, static_cast<size_t>(capacity) * stride, nullptr, BufferUsage::Dynamic);
+
+        for (uint32_t attribute = 0; attribute < 4; attribute++)
+            backend.EnableVertexAttribute(attribute);
+        backend.SetVertexAttribute(0, 2, stride, offsetof(Particle, Position));
+        backend.SetVertexAttribute(1, 2, stride, offsetof(Particle, Velocity));
+        backend.SetVertexAttribute(2, 4, stride, offsetof(Particle, Color));
+        backend.SetVertexAttribute(3, 4, stride, offsetof(Particle, Life));
+    }
+
+    backend.BindVertexArray(0);
+
+    m_Pending.reserve(std::min(capacity, PendingReserve));
+}
+
+ParticleSystem::~ParticleSystem()
+{
+    RendererAPI& backend = RendererAPI::Get();
+    for (uint32_t i = 0; i < 2; i++)
+    {
+        backend.DeleteBuffer(m_Buffers[i]);
+        backend.DeleteVertexArray(m_VertexArrays[i]);
+    }
+}
+
+void ParticleSystem::Emit(const Particle& particle)
+{
+    m_Pending.push_back(particle);
+}
+
+void ParticleSystem::Emit(const Burst& burst, const uint32_t count)
+{
+    const float baseAngle = std::atan2(burst.Direction.y, burst.Direction.x);
+    for (uint32_t i = 0; i < count; i++)
+    {
+        const float angle = baseAngle + (NextRandom(m_RandomState) * 2.0f - 1.0f) * burst.Spread;
+        const float speed = burst.MinSpeed + (burst.MaxSpeed - burst.MinSpeed) * NextRandom(m_RandomState);
+        const float lifetime = burst.MinLifetime + (burst.MaxLifetime - burst.MinLifetime) * NextRandom(m_RandomState);
+
+        m_Pending.push_back({ burst.Position, glm::vec2(std::cos(angle), std::sin(angle)) * speed, burst.Color,
+            lifetime, lifetime, burst.StartSize, burst.EndSize });
+    }
+}
+
+uint32_t ParticleSystem::Upload()
+{
+    if (m_Pending.empty() || m_Capacity == 0)
+        return 0;
+
+    // More than a full ring in one go: only the most recent ones would survive anyway
+    const auto pendingCount = static_cast<uint32_t>(m_Pending.size());
+    const uint32_t count = std::min(pendingCount, m_Capacity);
+    const Particle* particles = m_Pending.data() + (pendingCount - count);
+
+    for (uint32_t i = 0; i < count; i++)
+        m_TimeToIdle = std::max(m_TimeToIdle, particles[i].Life);
+
+    // At most two ranges, the second one when the ring wraps around
+    RendererAPI& backend = RendererAPI::Get();
+    backend.BindBuffer(BufferTarget::Vertex, m_Buffers[m_Source]);
+
+    const uint32_t firstCount = std::min(count, m_Capacity - m_Cursor);
+    backend.SetBufferSubData(BufferTarget::Vertex, static_cast<size_t>(m_Cursor) * sizeof(Particle), firstCount * sizeof(Particle), particles);
+    if (firstCount < count)
+        backend.SetBufferSubData(BufferTarget::Vertex, 0, (count - firstCount) * sizeof(Particle), particles + firstCount);
+
+    m_ActiveCount = std::max(m_ActiveCount, std::min(m_Capacity, m_Cursor + count));
+    m_Cursor = (m_Cursor + count) % m_Capacity;
+    m_Pending.clear();
+
+    return count * static_cast<uint32_t>(sizeof(Particle));
+}
+
+void ParticleSystem::Advance(const float deltaTime)
+{
+    m_Source ^= 1;
+    m_TimeToIdle -= deltaTime;
+}
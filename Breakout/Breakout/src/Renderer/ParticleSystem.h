@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+// GPU-resident particles for Renderer::UpdateParticles and Renderer::DrawParticles (brick debris, ball trails).
+// Particle state lives in two vertex buffers taking turns: each update reads one and writes the other through
+// transform feedback, so it never comes back to the CPU. The CPU only uploads newly emitted particles, which
+// overwrite the oldest slots of a ring.
+class ParticleSystem
+{
+public:
+    struct Particle
+    {
+        glm::vec2 Position;
+        glm::vec2 Velocity;
+        glm::vec4 Color;
+        float Life;      // seconds left
+        float Lifetime;  // seconds at emission, alpha and size follow Life / Lifetime
+        float StartSize; // point size in pixels
+        float EndSize;
+    };
+
+    // Particles leaving Position at random speeds, within Spread radians either side of Direction
+    struct Burst
+    {
+        glm::vec2 Position = glm::vec2(0.0f);
+        glm::vec2 Direction = glm::vec2(0.0f, -1.0f);
+        float Spread = 3.14159265f;
+        float MinSpeed = 50.0f;
+        float MaxSpeed = 150.0f;
+        float MinLifetime = 0.5f;
+        float MaxLifetime = 1.0f;
+        glm::vec4 Color = glm::vec4(1.0f);
+        float StartSize = 4.0f;
+        float EndSize = 0.0f;
+    };
+
+    explicit ParticleSystem(uint32_t capacity);
+    ParticleSystem(const ParticleSystem& other) = delete;
+    ~ParticleSystem();
+
+    // Queued until the next update
+    void Emit(const Particle& particle);
+    void Emit(const Burst& burst, uint32_t count);
+
+    // Constant acceleration applied to every particle
+    void SetGravity(const glm::vec2& gravity) { m_Gravity = gravity; }
+    const glm::vec2& GetGravity() const { return m_Gravity; }
+
+    uint32_t GetCapacity() const { return m_Capacity; }
+    // Slots simulated and drawn: every slot written so far, up to the capacity
+    uint32_t GetActiveCount() const { return m_ActiveCount; }
+    // True once every particle emitted has expired, updates and draws then do nothing
+    bool IsIdle() const { return m_TimeToIdle <= 0.0f && m_Pending.empty(); }
+private:
+    // Writes the pending particles into the source buffer, returns the number of bytes uploaded
+    uint32_t Upload();
+    // After an update: the buffer just written becomes the source
+    void Advance(float deltaTime);
+
+    friend class Renderer;
+private:
+    uint32_t m_Buffers[2] = {};
+    uint32_t m_VertexArrays[2] = {};
+    uint32_t m_Source = 0;
+
+    uint32_t m_Capacity;
+    uint32_t m_Cursor = 0;
+    uint32_t m_ActiveCount = 0;
+    // Longest life left among the particles emitted
+    float m_TimeToIdle = 0.0f;
+
+    glm::vec2 m_Gravity = glm::vec2(0.0f);
+    std::vector<Particle> m_Pending;
+    uint32_t m_RandomState = 0x9e3779b9u;
+};
@@ -1,30 +1,729 @@
 ﻿#include "Renderer.h"
 
-#include <glad/glad.h>
+#include "InstanceBuffer.h"
+#include "ParticleSystem.h"
+#include "RendererAPI.h"
+#include "Shader.h"
+#include "Texture2D.h"
+#include "TextureStreamer.h"
+#include "UniformBuffer.h"
 
-void Renderer::Initialize()
+#include "../Debug/Profiler.h"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+namespace
+{
+	struct QuadVertex
+	{
+		glm::vec3 Position;
+		glm::vec4 Color;
+		glm::vec2 TexCoord;
+		float TexIndex;
+	};
+
+	constexpr uint32_t MaxQuads = 10000;
+	constexpr uint32_t MaxVertices = MaxQuads * 4;
+	constexpr uint32_t MaxIndices = MaxQuads * 6;
+	// GL 3.3 guarantees at least 16 fragment texture image units
+	constexpr uint32_t MaxTextureSlots = 16;
+
+	// Frames of timer queries in flight before a slot is reused
+	constexpr uint32_t GpuQueryFrames = 4;
+	constexpr uint32_t MaxPassesPerFrame = 8;
+	// A pass opens a segment when it begins and its parent opens another one when it ends
+	constexpr uint32_t MaxSegmentsPerFrame = MaxPassesPerFrame * 2;
+	constexpr uint32_t NoParentPass = ~0u;
+
+	// GLSL 3.30 only allows sampler arrays to be indexed with constant expressions, hence the switch
+	const char* s_SpriteVertexSource = R"(
+#version 330 core
+layout (location = 0) in vec3 a_Position;
+layout (location = 1) in vec4 a_Color;
+layout (location = 2) in vec2 a_TexCoord;
+layout (location = 3) in float a_TexIndex;
+
+layout (std140) uniform FrameData
+{
+	mat4 u_ViewProjection;
+	vec2 u_ShakeOffset;
+	float u_Time;
+	float u_DeltaTime;
+};
+
+out vec4 v_Color;
+out vec2 v_TexCoord;
+flat out int v_TexIndex;
+
+void main()
+{
+	v_Color = a_Color;
+	v_TexCoord = a_TexCoord;
+	v_TexIndex = int(a_TexIndex);
+	gl_Position = u_ViewProjection * vec4(a_Position.xy + u_ShakeOffset, a_Position.z, 1.0);
+}
+)";
+
+	const char* s_SpriteFragmentSource = R"(
+#version 330 core
+in vec4 v_Color;
+in vec2 v_TexCoord;
+flat in int v_TexIndex;
+
+uniform sampler2D u_Textures[16];
+
+out vec4 o_Color;
+
+void main()
+{
+	vec4 texel;
+	switch (v_TexIndex)
+	{
+		case  0: texel = texture(u_Textures[ 0], v_TexCoord); break;
+		case  1: texel = texture(u_Textures[ 1], v_TexCoord); break;
+		case  2: texel = texture(u_Textures[ 2], v_TexCoord); break;
+		case  3: texel = texture(u_Textures[ 3], v_TexCoord); break;
+		case  4: texel = texture(u_Textures[ 4], v_TexCoord); break;
+		case  5: texel = texture(u_Textures[ 5], v_TexCoord); break;
+		case  6: texel = texture(u_Textures[ 6], v_TexCoord); break;
+		case  7: texel = texture(u_Textures[ 7], v_TexCoord); break;
+		case  8: texel = texture(u_Textures[ 8], v_TexCoord); break;
+		case  9: texel = texture(u_Textures[ 9], v_TexCoord); break;
+		case 10: texel = texture(u_Textures[10], v_TexCoord); break;
+		case 11: texel = texture(u_Textures[11], v_TexCoord); break;
+		case 12: texel = texture(u_Textures[12], v_TexCoord); break;
+		case 13: texel = texture(u_Textures[13], v_TexCoord); break;
+		case 14: texel = texture(u_Textures[14], v_TexCoord); break;
+		default: texel = texture(u_Textures[15], v_TexCoord); break;
+	}
+	o_Color = texel * v_Color;
+}
+)";
+
+	const char* s_InstancedVertexSource = R"(
+#version 330 core
+layout (location = 0) in vec2 a_Corner;
+layout (location = 1) in vec4 i_Rect;
+layout (location = 2) in vec4 i_Color;
+layout (location = 3) in vec4 i_UVRect;
+
+layout (std140) uniform FrameData
+{
+	mat4 u_ViewProjection;
+	vec2 u_ShakeOffset;
+	float u_Time;
+	float u_DeltaTime;
+};
+
+out vec4 v_Color;
+out vec2 v_TexCoord;
+
+void main()
+{
+	v_Color = i_Color;
+	v_TexCoord = vec2(mix(i_UVRect.x, i_UVRect.z, a_Corner.x), mix(i_UVRect.w, i_UVRect.y, a_Corner.y));
+	gl_Position = u_ViewProjection * vec4(i_Rect.xy + a_Corner * i_Rect.zw + u_ShakeOffset, 0.0, 1.0);
+}
+)";
+
+	const char* s_InstancedFragmentSource = R"(
+#version 330 core
+in vec4 v_Color;
+in vec2 v_TexCoord;
+
+uniform sampler2D u_Texture;
+
+out vec4 o_Color;
+
+void main()
+{
+	o_Color = texture(u_Texture, v_TexCoord) * v_Color;
+}
+)";
+
+	// Particle simulation step, captured through transform feedback in the layout of ParticleSystem::Particle.
+	// Expired particles are copied unchanged until their slot is emitted into again.
+	const char* s_ParticleUpdateSource = R"(
+#version 330 core
+layout (location = 0) in vec2 a_Position;
+layout (location = 1) in vec2 a_Velocity;
+layout (location = 2) in vec4 a_Color;
+layout (location = 3) in vec4 a_Life; // life left, lifetime, start size, end size
+
+uniform float u_TimeStep;
+uniform vec2 u_Gravity;
+
+out vec2 o_Position;
+out vec2 o_Velocity;
+out vec4 o_Color;
+out vec4 o_Life;
+
+void main()
+{
+	float timeStep = a_Life.x > 0.0 ? u_TimeStep : 0.0;
+	o_Velocity = a_Velocity + u_Gravity * timeStep;
+	o_Position = a_Position + o_Velocity * timeStep;
+	o_Color = a_Color;
+	o_Life = vec4(a_Life.x - timeStep, a_Life.yzw);
+}
+)";
+
+	const char* s_ParticleVertexSource = R"(
+#version 330 core
+layout (location = 0) in vec2 a_Position;
+layout (location = 2) in vec4 a_Color;
+layout (location = 3) in vec4 a_Life;
+
+layout (std140) uniform FrameData
+{
+	mat4 u_ViewProjection;
+	vec2 u_ShakeOffset;
+	float u_Time;
+	float u_DeltaTime;
+};
+
+out vec4 v_Color;
+
+void main()
 {
-	glEnable(GL_BLEND);
-	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+	// 1 when emitted, 0 when expired: fades and shrinks the particle
+	float remaining = clamp(a_Life.x / max(a_Life.y, 1e-6), 0.0, 1.0);
+	v_Color = vec4(a_Color.rgb, a_Color.a * remaining);
 
-	glEnable(GL_DEPTH_TEST);
+	// Expired particles are moved out of the clip volume
+	bool alive = a_Life.x > 0.0;
+	gl_PointSize = alive ? mix(a_Life.w, a_Life.z, remaining) : 0.0;
+	gl_Position = alive ? u_ViewProjection * vec4(a_Position + u_ShakeOffset, 0.0, 1.0) : vec4(2.0, 2.0, 2.0, 1.0);
+}
+)";
+
+	const char* s_ParticleFragmentSource = R"(
+#version 330 core
+in vec4 v_Color;
+
+out vec4 o_Color;
+
+void main()
+{
+	// Round sprite with a soft edge
+	float alpha = v_Color.a * (1.0 - smoothstep(0.6, 1.0, length(gl_PointCoord * 2.0 - 1.0)));
+	if (alpha <= 0.0)
+		discard;
+	o_Color = vec4(v_Color.rgb, alpha);
+}
+)";
+
+	struct GpuPass
+	{
+		const char* Name;
+		uint64_t CpuStart; // profiler clock when the pass was submitted, anchors the GPU zone in the trace
+		uint32_t Parent;   // index of the enclosing pass, NoParentPass at the top level
+	};
+
+	// Stretch of a pass timed by one query, until a nested pass suspends it or the pass ends
+	struct PassSegment
+	{
+		uint32_t Pass;
+		uint32_t Query;
+	};
+
+	struct QueryFrame
+	{
+		std::array<GpuPass, MaxPassesPerFrame> Passes{}; // in the order they began, children after their parent
+		std::array<PassSegment, MaxSegmentsPerFrame> Segments{};
+		uint32_t PassCount = 0;
+		uint32_t SegmentCount = 0;
+	};
+
+	struct BatchData
+	{
+		unsigned int VertexArray = 0;
+		unsigned int VertexBuffer = 0;
+		unsigned int IndexBuffer = 0;
+
+		unsigned int InstancedVertexArray = 0;
+		unsigned int UnitQuadBuffer = 0;
+
+		std::unique_ptr<Shader> SpriteShader;
+		std::unique_ptr<Shader> InstancedShader;
+		std::unique_ptr<Shader> ParticleUpdateShader;
+		std::unique_ptr<Shader> ParticleShader;
+		UniformHandle ParticleTimeStep;
+		UniformHandle ParticleGravity;
+		std::unique_ptr<UniformBuffer> FrameUniforms;
+		std::unique_ptr<TextureStreamer> Streamer;
+		std::unique_ptr<Texture2D> WhiteTexture;
+
+		std::vector<QuadVertex> Vertices;
+		uint32_t QuadCount = 0;
+
+		std::array<const Texture2D*, MaxTextureSlots> TextureSlots{};
+		uint32_t TextureSlotCount = 1; // 0 = white texture
+
+		Renderer::Statistics Stats;
+
+		std::array<QueryFrame, GpuQueryFrames> QueryFrames{};
+		std::array<uint32_t, GpuQueryFrames * MaxSegmentsPerFrame> Queries{};
+		uint32_t QueryFrameIndex = 0;
+		std::array<uint32_t, MaxPassesPerFrame> PassStack{};
+		uint32_t PassDepth = 0;
+		uint32_t DroppedPassDepth = 0; // open passes over the budget, everything nested in them is dropped too
+		uint64_t GpuTrackEnd = 0;
+		std::vector<Renderer::GpuPassTiming> GpuTimings;
+	};
+
+	BatchData s_Data;
+
+	void BeginPassSegment(QueryFrame& frame, const uint32_t pass)
+	{
+		const uint32_t segment = frame.SegmentCount++;
+		const uint32_t query = s_Data.Queries[s_Data.QueryFrameIndex * MaxSegmentsPerFrame + segment];
+		frame.Segments[segment] = { pass, query };
+		RendererAPI::Get().BeginTimerQuery(query);
+	}
+}
+
+void Renderer::Initialize(const RendererAPI::API api /* = RendererAPI::API::OpenGL */)
+{
+	RendererAPI::Create(api);
+	RendererAPI& backend = RendererAPI::Get();
+	backend.Initialize();
+
+	// Sprite batch: one persistent vertex buffer, re-filled (not re-allocated) on every flush
+	s_Data.Vertices.resize(MaxVertices);
+
+	s_Data.VertexArray = backend.CreateVertexArray();
+	backend.BindVertexArray(s_Data.VertexArray);
+
+	s_Data.VertexBuffer = backend.CreateBuffer();
+	backend.BindBuffer(BufferTarget::Vertex, s_Data.VertexBuffer);
+	backend.SetBufferData(BufferTarget::Vertex, MaxVertices * sizeof(QuadVertex), nullptr, BufferUsage::Dynamic);
+
+	backend.EnableVertexAttribute(0);
+	backend.SetVertexAttribute(0, 3, sizeof(QuadVertex), offsetof(QuadVertex, Position));
+	backend.EnableVertexAttribute(1);
+	backend.SetVertexAttribute(1, 4, sizeof(QuadVertex), offsetof(QuadVertex, Color));
+	backend.EnableVertexAttribute(2);
+	backend.SetVertexAttribute(2, 2, sizeof(QuadVertex), offsetof(QuadVertex, TexCoord));
+	backend.EnableVertexAttribute(3);
+	backend.SetVertexAttribute(3, 1, sizeof(QuadVertex), offsetof(QuadVertex, TexIndex));
+
+	// Index pattern never changes, upload it once
+	std::vector<uint32_t> indices(MaxIndices);
+	for (uint32_t i = 0, offset = 0; i < MaxIndices; i += 6, offset += 4)
+	{
+		indices[i + 0] = offset + 0;
+		indices[i + 1] = offset + 1;
+		indices[i + 2] = offset + 2;
+		indices[i + 3] = offset + 2;
+		indices[i + 4] = offset + 3;
+		indices[i + 5] = offset + 0;
+	}
+
+	s_Data.IndexBuffer = backend.CreateBuffer();
+	backend.BindBuffer(BufferTarget::Index, s_Data.IndexBuffer);
+	backend.SetBufferData(BufferTarget::Index, MaxIndices * sizeof(uint32_t), indices.data(), BufferUsage::Static);
+
+	backend.BindVertexArray(0);
+
+	s_Data.FrameUniforms = std::make_unique<UniformBuffer>(static_cast<uint32_t>(sizeof(FrameData)), UniformBinding::Frame);
+	s_Data.Streamer = std::make_unique<TextureStreamer>();
+
+	// Untextured quads sample a 1x1 white texture so that everything goes through the same shader
+	constexpr uint32_t whitePixel = 0xffffffff;
+	s_Data.WhiteTexture = std::make_unique<Texture2D>(1, 1, 4);
+	s_Data.WhiteTexture->Bind();
+	s_Data.WhiteTexture->SetData(&whitePixel, TextureFormat::RGBA, PixelType::UnsignedByte);
+	s_Data.WhiteTexture->SetFilterMode(TextureFilter::Nearest);
+	s_Data.WhiteTexture->SetWrapMode(TextureWrap::Repeat);
+	s_Data.TextureSlots[0] = s_Data.WhiteTexture.get();
+
+	int samplers[MaxTextureSlots];
+	for (uint32_t i = 0; i < MaxTextureSlots; i++)
+		samplers[i] = static_cast<int>(i);
+
+	s_Data.SpriteShader = std::make_unique<Shader>(s_SpriteVertexSource, s_SpriteFragmentSource);
+	s_Data.SpriteShader->Use();
+	s_Data.SpriteShader->SetIntegerArray("u_Textures", samplers, MaxTextureSlots);
+
+	// Instanced path: a unit quad drawn as a triangle strip, the instance attributes are bound at draw time
+	constexpr float unitQuad[] = { 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 1.0f, 1.0f, 1.0f };
+
+	s_Data.InstancedVertexArray = backend.CreateVertexArray();
+	backend.BindVertexArray(s_Data.InstancedVertexArray);
+
+	s_Data.UnitQuadBuffer = backend.CreateBuffer();
+	backend.BindBuffer(BufferTarget::Vertex, s_Data.UnitQuadBuffer);
+	backend.SetBufferData(BufferTarget::Vertex, sizeof(unitQuad), unitQuad, BufferUsage::Static);
+
+	backend.EnableVertexAttribute(0);
+	backend.SetVertexAttribute(0, 2, 2 * sizeof(float), 0);
+	for (uint32_t attribute = 1; attribute <= 3; attribute++)
+		backend.EnableVertexAttribute(attribute, 1);
+
+	backend.BindVertexArray(0);
+
+	s_Data.InstancedShader = std::make_unique<Shader>(s_InstancedVertexSource, s_InstancedFragmentSource);
+	s_Data.InstancedShader->Use();
+	s_Data.InstancedShader->SetInteger("u_Texture", 0);
+
+	// Particles: simulation outputs in the order of ParticleSystem::Particle's fields
+	s_Data.ParticleUpdateShader = std::make_unique<Shader>(s_ParticleUpdateSource, std::vector<const char*>{ "o_Position", "o_Velocity", "o_Color", "o_Life" });
+	s_Data.ParticleTimeStep = s_Data.ParticleUpdateShader->GetUniformHandle("u_TimeStep");
+	s_Data.ParticleGravity = s_Data.ParticleUpdateShader->GetUniformHandle("u_Gravity");
+	s_Data.ParticleShader = std::make_unique<Shader>(s_ParticleVertexSource, s_ParticleFragmentSource);
+
+	for (uint32_t& query : s_Data.Queries)
+		query = backend.CreateQuery();
 }
 
 void Renderer::Shutdown()
 {
+	RendererAPI& backend = RendererAPI::Get();
+	if (s_Data.SpriteShader)
+		backend.DeleteProgram(s_Data.SpriteShader->GetID());
+	if (s_Data.InstancedShader)
+		backend.DeleteProgram(s_Data.InstancedShader->GetID());
+	if (s_Data.ParticleUpdateShader)
+		backend.DeleteProgram(s_Data.ParticleUpdateShader->GetID());
+	if (s_Data.ParticleShader)
+		backend.DeleteProgram(s_Data.ParticleShader->GetID());
+	if (s_Data.WhiteTexture)
+		backend.DeleteTexture(s_Data.WhiteTexture->GetID());
+
+	backend.DeleteBuffer(s_Data.VertexBuffer);
+	backend.DeleteBuffer(s_Data.IndexBuffer);
+	backend.DeleteVertexArray(s_Data.VertexArray);
+	backend.DeleteBuffer(s_Data.UnitQuadBuffer);
+	backend.DeleteVertexArray(s_Data.InstancedVertexArray);
+	for (const uint32_t query : s_Data.Queries)
+		backend.DeleteQuery(query);
+
+	s_Data = BatchData();
 }
 
 void Renderer::SetViewport(int x, int y, int width, int height)
 {
-	glViewport(x, y, width, height);
+	RendererAPI::Get().SetViewport(x, y, width, height);
 }
 
 void Renderer::SetClearColor(const glm::vec4& color)
 {
-	glClearColor(color.r, color.g, color.b, color.a);
+	RendererAPI::Get().SetClearColor(color);
 }
 
 void Renderer::Clear()
 {
-	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+	RendererAPI::Get().Clear();
+}
+
+void Renderer::Finish()
+{
+	RendererAPI::Get().Finish();
+}
+
+void Renderer::BeginFrame(const FrameData& frameData)
+{
+	s_Data.FrameUniforms->SetData(&frameData, sizeof(FrameData));
+
+	assert(s_Data.PassDepth == 0 && s_Data.DroppedPassDepth == 0 && "BeginPass without a matching EndPass");
+
+	ResolveGpuQueries();
+
+	// The GPU is more than GpuQueryFrames frames behind: drop the oldest results rather than wait for them
+	s_Data.QueryFrameIndex = (s_Data.QueryFrameIndex + 1) % GpuQueryFrames;
+	s_Data.QueryFrames[s_Data.QueryFrameIndex].PassCount = 0;
+	s_Data.QueryFrames[s_Data.QueryFrameIndex].SegmentCount = 0;
+}
+
+void Renderer::BeginPass(const char* name)
+{
+	QueryFrame& frame = s_Data.QueryFrames[s_Data.QueryFrameIndex];
+	if (s_Data.DroppedPassDepth > 0 || frame.PassCount >= MaxPassesPerFrame)
+	{
+		// The enclosing pass, if any, keeps running and includes this one
+		s_Data.DroppedPassDepth++;
+		s_Data.Stats.DroppedGpuPasses++;
+		return;
+	}
+
+	const uint32_t parent = s_Data.PassDepth > 0 ? s_Data.PassStack[s_Data.PassDepth - 1] : NoParentPass;
+	if (parent != NoParentPass)
+		RendererAPI::Get().EndTimerQuery();
+
+	const uint32_t pass = frame.PassCount++;
+	frame.Passes[pass] = { name, Profiler::Now(), parent };
+	s_Data.PassStack[s_Data.PassDepth++] = pass;
+	BeginPassSegment(frame, pass);
+}
+
+void Renderer::EndPass()
+{
+	if (s_Data.DroppedPassDepth > 0)
+	{
+		s_Data.DroppedPassDepth--;
+		return;
+	}
+
+	assert(s_Data.PassDepth > 0 && "EndPass without a matching BeginPass");
+	if (s_Data.PassDepth == 0)
+		return;
+
+	RendererAPI::Get().EndTimerQuery();
+	s_Data.PassDepth--;
+	if (s_Data.PassDepth > 0)
+		BeginPassSegment(s_Data.QueryFrames[s_Data.QueryFrameIndex], s_Data.PassStack[s_Data.PassDepth - 1]);
+}
+
+const std::vector<Renderer::GpuPassTiming>& Renderer::GetGpuTimings()
+{
+	return s_Data.GpuTimings;
+}
+
+void Renderer::BeginBatch()
+{
+	StartBatch();
+}
+
+void Renderer::Submit(const glm::vec2& position, const glm::vec2& size, const glm::vec4& color)
+{
+	SubmitQuad(glm::vec3(position, 0.0f), size, glm::vec4(0.0f, 0.0f, 1.0f, 1.0f), color, 0.0f);
+}
+
+void Renderer::Submit(const glm::vec3& position, const glm::vec2& size, const glm::vec4& color)
+{
+	SubmitQuad(position, size, glm::vec4(0.0f, 0.0f, 1.0f, 1.0f), color, 0.0f);
+}
+
+void Renderer::Submit(const glm::vec2& position, const glm::vec2& size, const Texture2D& texture, const glm::vec4& tint /* = glm::vec4(1.0f) */)
+{
+	Submit(glm::vec3(position, 0.0f), size, texture, glm::vec4(0.0f, 0.0f, 1.0f, 1.0f), tint);
+}
+
+void Renderer::Submit(const glm::vec3& position, const glm::vec2& size, const Texture2D& texture, const glm::vec4& tint /* = glm::vec4(1.0f) */)
+{
+	Submit(position, size, texture, glm::vec4(0.0f, 0.0f, 1.0f, 1.0f), tint);
+}
+
+void Renderer::Submit(const glm::vec3& position, const glm::vec2& size, const Texture2D& texture, const glm::vec4& uvRect, const glm::vec4& tint)
+{
+	const float textureIndex = GetTextureSlot(texture);
+	SubmitQuad(position, size, uvRect, tint, textureIndex);
+}
+
+void Renderer::EndBatch()
+{
+	Flush();
+}
+
+void Renderer::DrawInstanced(InstanceBuffer& instances, const Texture2D* texture /* = nullptr */)
+{
+	if (instances.GetCount() == 0)
+		return;
+
+	s_Data.Stats.InstanceBytesUploaded += instances.Upload();
+
+	RendererAPI& backend = RendererAPI::Get();
+	backend.BindVertexArray(s_Data.InstancedVertexArray);
+	backend.BindBuffer(BufferTarget::Vertex, instances.GetID());
+
+	constexpr auto stride = static_cast<uint32_t>(sizeof(InstanceBuffer::Instance));
+	backend.SetVertexAttribute(1, 4, stride, offsetof(InstanceBuffer::Instance, Position));
+	backend.SetVertexAttribute(2, 4, stride, offsetof(InstanceBuffer::Instance, Color));
+	backend.SetVertexAttribute(3, 4, stride, offsetof(InstanceBuffer::Instance, UVRect));
+
+	(texture != nullptr ? texture : s_Data.WhiteTexture.get())->Bind(0);
+
+	s_Data.InstancedShader->Use();
+
+	backend.DrawArraysInstanced(PrimitiveType::TriangleStrip, 4, instances.GetCount());
+	backend.BindVertexArray(0);
+
+	s_Data.Stats.DrawCalls++;
+	s_Data.Stats.InstanceCount += instances.GetCount();
+}
+
+void Renderer::UpdateParticles(ParticleSystem& particles, const float deltaTime)
+{
+	s_Data.Stats.ParticleBytesUploaded += particles.Upload();
+	if (particles.IsIdle())
+		return;
+
+	s_Data.ParticleUpdateShader->Use();
+	s_Data.ParticleUpdateShader->SetFloat(s_Data.ParticleTimeStep, deltaTime);
+	s_Data.ParticleUpdateShader->SetVector2f(s_Data.ParticleGravity, particles.GetGravity());
+
+	// Reads the source buffer, writes the other one
+	RendererAPI& backend = RendererAPI::Get();
+	backend.SetRasterizerDiscard(true);
+	backend.BindVertexArray(particles.m_VertexArrays[particles.m_Source]);
+	backend.BindBufferBase(BufferTarget::TransformFeedback, 0, particles.m_Buffers[particles.m_Source ^ 1]);
+
+	backend.BeginTransformFeedback(PrimitiveType::Points);
+	backend.DrawArraysInstanced(PrimitiveType::Points, particles.GetActiveCount(), 1);
+	backend.EndTransformFeedback();
+
+	backend.BindBufferBase(BufferTarget::TransformFeedback, 0, 0);
+	backend.BindVertexArray(0);
+	backend.SetRasterizerDiscard(false);
+
+	particles.Advance(deltaTime);
+}
+
+void Renderer::DrawParticles(const ParticleSystem& particles)
+{
+	if (particles.IsIdle())
+		return;
+
+	RendererAPI& backend = RendererAPI::Get();
+	backend.BindVertexArray(particles.m_VertexArrays[particles.m_Source]);
+	s_Data.ParticleShader->Use();
+
+	backend.DrawArraysInstanced(PrimitiveType::Points, particles.GetActiveCount(), 1);
+	backend.BindVertexArray(0);
+
+	s_Data.Stats.DrawCalls++;
+	s_Data.Stats.ParticleCount += particles.GetActiveCount();
+}
+
+TextureStreamer& Renderer::GetTextureStreamer()
+{
+	return *s_Data.Streamer;
+}
+
+const Renderer::Statistics& Renderer::GetStats()
+{
+	return s_Data.Stats;
+}
+
+void Renderer::ResetStats()
+{
+	s_Data.Stats = Statistics();
+}
+
+void Renderer::SubmitQuad(const glm::vec3& position, const glm::vec2& size, const glm::vec4& uvRect, const glm::vec4& color, const float textureIndex)
+{
+	// Vertex buffer is full: draw it and keep going, the texture slot table is still valid
+	if (s_Data.QuadCount >= MaxQuads)
+		Flush();
+
+	// Textures are flipped on load, so the top edge of the quad samples the top of the image (v1)
+	QuadVertex* vertex = &s_Data.Vertices[s_Data.QuadCount * 4];
+	vertex[0] = { position, color, { uvRect.x, uvRect.w }, textureIndex };
+	vertex[1] = { { position.x + size.x, position.y, position.z }, color, { uvRect.z, uvRect.w }, textureIndex };
+	vertex[2] = { { position.x + size.x, position.y + size.y, position.z }, color, { uvRect.z, uvRect.y }, textureIndex };
+	vertex[3] = { { position.x, position.y + size.y, position.z }, color, { uvRect.x, uvRect.y }, textureIndex };
+
+	s_Data.QuadCount++;
+	s_Data.Stats.QuadCount++;
+}
+
+float Renderer::GetTextureSlot(const Texture2D& texture)
+{
+	for (uint32_t i = 1; i < s_Data.TextureSlotCount; i++)
+	{
+		if (s_Data.TextureSlots[i]->GetID() == texture.GetID())
+			return static_cast<float>(i);
+	}
+
+	// Every slot is taken: draw what we have so far and start over with an empty slot table
+	if (s_Data.TextureSlotCount >= MaxTextureSlots)
+	{
+		Flush();
+		StartBatch();
+	}
+
+	const uint32_t slot = s_Data.TextureSlotCount++;
+	s_Data.TextureSlots[slot] = &texture;
+	return static_cast<float>(slot);
+}
+
+void Renderer::StartBatch()
+{
+	s_Data.QuadCount = 0;
+	s_Data.TextureSlotCount = 1;
+}
+
+void Renderer::Flush()
+{
+	if (s_Data.QuadCount == 0)
+		return;
+
+	RendererAPI& backend = RendererAPI::Get();
+	backend.BindBuffer(BufferTarget::Vertex, s_Data.VertexBuffer);
+	backend.SetBufferSubData(BufferTarget::Vertex, 0, s_Data.QuadCount * 4 * sizeof(QuadVertex), s_Data.Vertices.data());
+
+	for (uint32_t i = 0; i < s_Data.TextureSlotCount; i++)
+		s_Data.TextureSlots[i]->Bind(i);
+
+	s_Data.SpriteShader->Use();
+	backend.BindVertexArray(s_Data.VertexArray);
+	backend.DrawIndexed(PrimitiveType::Triangles, s_Data.QuadCount * 6);
+	backend.BindVertexArray(0);
+
+	s_Data.Stats.DrawCalls++;
+	s_Data.QuadCount = 0;
+}
+
+void Renderer::ResolveGpuQueries()
+{
+	RendererAPI& backend = RendererAPI::Get();
+
+	// Oldest frame first, the GPU finishes them in order: the first one still pending ends the readback
+	for (uint32_t i = 1; i <= GpuQueryFrames; i++)
+	{
+		QueryFrame& frame = s_Data.QueryFrames[(s_Data.QueryFrameIndex + i) % GpuQueryFrames];
+		if (frame.PassCount == 0)
+			continue;
+
+		std::array<uint64_t, MaxPassesPerFrame> elapsed{};
+		for (uint32_t segment = 0; segment < frame.SegmentCount; segment++)
+		{
+			uint64_t nanoseconds = 0;
+			if (!backend.GetQueryResult(frame.Segments[segment].Query, nanoseconds))
+				return;
+			elapsed[frame.Segments[segment].Pass] += nanoseconds;
+		}
+
+		// Children come after their parent: going backwards, a pass is complete when it is added to its parent
+		for (uint32_t pass = frame.PassCount; pass-- > 0;)
+		{
+			if (frame.Passes[pass].Parent != NoParentPass)
+				elapsed[frame.Passes[pass].Parent] += elapsed[pass];
+		}
+
+		// End of the last child laid out in each pass
+		std::array<uint64_t, MaxPassesPerFrame> childEnds{};
+		for (uint32_t pass = 0; pass < frame.PassCount; pass++)
+		{
+			const GpuPass& gpuPass = frame.Passes[pass];
+
+			// Only durations are known: GPU zones are laid out back to back, no earlier than their submission,
+			// nested ones from the start of their parent
+			uint64_t& end = gpuPass.Parent != NoParentPass ? childEnds[gpuPass.Parent] : s_Data.GpuTrackEnd;
+			const uint64_t start = std::max(gpuPass.CpuStart, end);
+			end = start + elapsed[pass];
+			childEnds[pass] = start;
+#if BREAKOUT_PROFILE
+			Profiler::RecordGpu(gpuPass.Name, start, start + elapsed[pass]);
+#endif
+
+			const float milliseconds = static_cast<float>(elapsed[pass]) / 1000000.0f;
+			const auto timing = std::find_if(s_Data.GpuTimings.begin(), s_Data.GpuTimings.end(),
+				[&gpuPass](const GpuPassTiming& other) { return std::strcmp(other.Name, gpuPass.Name) == 0; });
+			if (timing != s_Data.GpuTimings.end())
+				timing->Milliseconds = milliseconds;
+			else
+				s_Data.GpuTimings.push_back({ gpuPass.Name, milliseconds });
+		}
+
+		frame.PassCount = 0;
+		frame.SegmentCount = 0;
+	}
 }
@@ -1,16 +1,100 @@
 ﻿#pragma once
 
+#include "RendererAPI.h"
+
 #include <cstdint>
+#include <vector>
 #include <glm/glm.hpp>
 
+class InstanceBuffer;
+class ParticleSystem;
+class Texture2D;
+class TextureStreamer;
+
 class Renderer
 {
 public:
-    static void Initialize();
+    struct Statistics
+    {
+        uint32_t DrawCalls = 0;
+        uint32_t QuadCount = 0;
+        uint32_t InstanceCount = 0;
+        uint32_t InstanceBytesUploaded = 0;
+        uint32_t ParticleCount = 0;
+        uint32_t ParticleBytesUploaded = 0;
+        uint32_t DroppedGpuPasses = 0; // passes over MaxPassesPerFrame, left untimed
+    };
+
+    // Per-frame data shared by every shader through the "FrameData" uniform block (std140 layout)
+    struct FrameData
+    {
+        glm::mat4 ViewProjection = glm::mat4(1.0f);
+        glm::vec2 ShakeOffset = glm::vec2(0.0f);
+        float Time = 0.0f;
+        float DeltaTime = 0.0f;
+    };
+
+    struct GpuPassTiming
+    {
+        const char* Name;
+        float Milliseconds; // latest result read back, a few frames old
+    };
+
+    // Every GPU call made by the renderer and the resource classes goes through the chosen backend
+    static void Initialize(RendererAPI::API api = RendererAPI::API::OpenGL);
     static void Shutdown();
 
     static void SetViewport(int x, int y, int width, int height);
     static void SetClearColor(const glm::vec4& color);
     static void Clear();
+    // Waits for the GPU to complete the commands issued so far, for CPU timings that include the GPU work
+    static void Finish();
+
+    // Uploads the frame data once, every program reads it from the shared uniform block.
+    // Also reads back the GPU pass timings of previous frames that have completed.
+    static void BeginFrame(const FrameData& frameData);
+
+    // GPU timing: the commands issued between BeginPass and EndPass are timed with a timer query. Queries cycle
+    // through a ring spanning several frames and are only read once the GPU is done with them, so results lag a
+    // few frames behind but never stall the pipeline. Passes may nest: timer queries cannot, so the enclosing pass
+    // is suspended while a nested one runs and its time is the sum of its segments plus its children's.
+    // Name must be a string literal. Results also go to the profiler's GPU track.
+    static void BeginPass(const char* name);
+    static void EndPass();
+    // One entry per pass name seen so far
+    static const std::vector<GpuPassTiming>& GetGpuTimings();
+
+    // Sprite batching: every quad submitted between BeginBatch and EndBatch is packed into a single
+    // vertex buffer and drawn with as few draw calls as possible (one per batch of texture slots).
+    // Positions are the top-left corner of the quad, in the space of the frame's view-projection (y pointing down).
+    static void BeginBatch();
+    static void Submit(const glm::vec2& position, const glm::vec2& size, const glm::vec4& color);
+    static void Submit(const glm::vec3& position, const glm::vec2& size, const glm::vec4& color);
+    static void Submit(const glm::vec2& position, const glm::vec2& size, const Texture2D& texture, const glm::vec4& tint = glm::vec4(1.0f));
+    static void Submit(const glm::vec3& position, const glm::vec2& size, const Texture2D& texture, const glm::vec4& tint = glm::vec4(1.0f));
+    // uvRect holds the (u0, v0, u1, v1) sub-rectangle of the texture to sample
+    static void Submit(const glm::vec3& position, const glm::vec2& size, const Texture2D& texture, const glm::vec4& uvRect, const glm::vec4& tint);
+    static void EndBatch();
+
+    // Instanced path: a single unit quad drawn once per instance of the buffer, whose pending
+    // changes are uploaded right before the draw. Meant for mostly static geometry such as the brick field.
+    static void DrawInstanced(InstanceBuffer& instances, const Texture2D* texture = nullptr);
+
+    // GPU particles: UpdateParticles uploads the particles emitted since the previous update, then advances every
+    // particle by deltaTime in the vertex stage (transform feedback, rasterizer discarded). DrawParticles draws them
+    // as point sprites in a single draw call. Neither reads anything back from the GPU.
+    static void UpdateParticles(ParticleSystem& particles, float deltaTime);
+    static void DrawParticles(const ParticleSystem& particles);
+
+    // Shared pixel buffer ring for textures updated every frame
+    static TextureStreamer& GetTextureStreamer();
+
+    static const Statistics& GetStats();
+    static void ResetStats();
 private:
+    static void SubmitQuad(const glm::vec3& position, const glm::vec2& size, const glm::vec4& uvRect, const glm::vec4& color, float textureIndex);
+    static float GetTextureSlot(const Texture2D& texture);
+    static void StartBatch();
+    static void Flush();
+    static void ResolveGpuQueries();
 };
@@ -0,0 +1,23 @@
+#include "RendererAPI.h"
+
+#include "NullRendererAPI.h"
+#include "OpenGLRendererAPI.h"
+
+RendererAPI::API RendererAPI::s_API = RendererAPI::API::OpenGL;
+RendererAPI* RendererAPI::s_Instance = nullptr;
+
+void RendererAPI::Create(const API api)
+{
+    delete s_Instance;
+
+    s_API = api;
+    switch (api)
+    {
+        case API::Null:
+            s_Instance = new NullRendererAPI();
+            break;
+        case API::OpenGL:
+            s_Instance = new OpenGLRendererAPI();
+            break;
+    }
+}
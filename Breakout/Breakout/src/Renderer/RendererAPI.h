@@ -0,0 +1,183 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+enum class BufferTarget : uint8_t
+{
+    Vertex,
+    Index,
+    Uniform,
+    PixelUnpack,
+    TransformFeedback
+};
+
+enum class BufferUsage : uint8_t
+{
+    Static,
+    Dynamic,
+    Stream
+};
+
+enum class PrimitiveType : uint8_t
+{
+    Triangles,
+    TriangleStrip,
+    Points
+};
+
+// Channels of the texels, both as stored in the texture and as laid out in the uploaded data
+enum class TextureFormat : uint8_t
+{
+    Red,
+    RG,
+    RGB,
+    RGBA
+};
+
+// Type of each channel of the uploaded data, 8-bit channels are stored normalized
+enum class PixelType : uint8_t
+{
+    UnsignedByte,
+    UnsignedShort,
+    HalfFloat,
+    Float
+};
+
+// Applies to both minification and magnification
+enum class TextureFilter : uint8_t
+{
+    Nearest,
+    Linear
+};
+
+// Applies to both texture axes
+enum class TextureWrap : uint8_t
+{
+    Repeat,
+    ClampToEdge
+};
+
+enum class UniformType : uint8_t
+{
+    Float,
+    Integer,
+    Vector2f,
+    Vector3f,
+    Vector4f,
+    Matrix4
+};
+
+// Active uniform of a linked program, Size is in bytes (whole array for array uniforms). The Count elements of an
+// array occupy consecutive locations starting at Location.
+struct ProgramUniform
+{
+    std::string Name;
+    int Location;
+    uint32_t Size;
+    uint32_t Count;
+};
+
+// Every GPU command issued by Renderer, Shader, Texture2D and the buffer classes goes through the current backend.
+// Objects are plain handles and every enum is translated by the backend, so no caller depends on a graphics API.
+// Like OpenGL, texture and buffer updates apply to whatever is currently bound.
+class RendererAPI
+{
+public:
+    enum class API : uint8_t
+    {
+        // Records commands instead of executing them, needs no GPU nor context
+        Null,
+        OpenGL
+    };
+
+    virtual ~RendererAPI() = default;
+
+    // Default pipeline state: alpha blending, depth test, point size written by the vertex shader
+    virtual void Initialize() = 0;
+
+    virtual void SetViewport(int x, int y, int width, int height) = 0;
+    virtual void SetClearColor(const glm::vec4& color) = 0;
+    virtual void Clear() = 0;
+    // Blocks until every command issued so far has completed
+    virtual void Finish() = 0;
+
+    // Buffers
+    virtual uint32_t CreateBuffer() = 0;
+    virtual void DeleteBuffer(uint32_t buffer) = 0;
+    virtual void BindBuffer(BufferTarget target, uint32_t buffer) = 0;
+    virtual void BindBufferBase(BufferTarget target, uint32_t index, uint32_t buffer) = 0;
+    virtual void SetBufferData(BufferTarget target, size_t size, const void* data, BufferUsage usage) = 0;
+    virtual void SetBufferSubData(BufferTarget target, size_t offset, size_t size, const void* data) = 0;
+    // Write-only mapping of the first size bytes, previous contents are discarded
+    virtual void* MapBuffer(BufferTarget target, size_t size) = 0;
+    virtual void UnmapBuffer(BufferTarget target) = 0;
+
+    // Vertex arrays, attributes are always floats
+    virtual uint32_t CreateVertexArray() = 0;
+    virtual void DeleteVertexArray(uint32_t vertexArray) = 0;
+    virtual void BindVertexArray(uint32_t vertexArray) = 0;
+    virtual void EnableVertexAttribute(uint32_t index, uint32_t divisor = 0) = 0;
+    // Sources the attribute from the currently bound vertex buffer
+    virtual void SetVertexAttribute(uint32_t index, int components, uint32_t stride, size_t offset) = 0;
+
+    // Textures
+    virtual uint32_t CreateTexture() = 0;
+    virtual void DeleteTexture(uint32_t texture) = 0;
+    virtual void BindTexture(uint32_t slot, uint32_t texture) = 0;
+    // data is a byte offset when a pixel unpack buffer is bound
+    virtual void SetTextureData(int width, int height, TextureFormat format, PixelType type, const void* data) = 0;
+    virtual void SetTextureSubData(int x, int y, int width, int height, TextureFormat format, PixelType type, const void* data) = 0;
+    virtual void SetTextureFilter(TextureFilter filter) = 0;
+    virtual void SetTextureWrap(TextureWrap wrap) = 0;
+    virtual void SetUnpackAlignment(int alignment) = 0;
+
+    // Programs, shared uniform blocks are bound to their UniformBinding while linking
+    virtual uint32_t CreateProgram(const char* vertexSource, const char* fragmentSource, const char* geometrySource) = 0;
+    // Vertex-only program for transform feedback: the outputs named by varyings are captured interleaved, in that
+    // order, into the buffer bound at transform feedback index 0
+    virtual uint32_t CreateFeedbackProgram(const char* vertexSource, const std::vector<const char*>& varyings) = 0;
+    virtual void DeleteProgram(uint32_t program) = 0;
+    virtual void UseProgram(uint32_t program) = 0;
+    virtual void GetProgramUniforms(uint32_t program, std::vector<ProgramUniform>& outUniforms) = 0;
+    // Applies to the program in use
+    virtual void SetUniform(int location, UniformType type, int count, const void* data) = 0;
+
+    // Offscreen render targets with an RGBA8 color and a depth attachment, 0 is the window's framebuffer
+    virtual uint32_t CreateFramebuffer(int width, int height) = 0;
+    virtual void DeleteFramebuffer(uint32_t framebuffer) = 0;
+    virtual void BindFramebuffer(uint32_t framebuffer) = 0;
+    // Tightly packed RGBA8 rows of the bound framebuffer, bottom row first
+    virtual void ReadPixels(int x, int y, int width, int height, void* outPixels) = 0;
+
+    // GPU timer queries, only one can be running at a time
+    virtual uint32_t CreateQuery() = 0;
+    virtual void DeleteQuery(uint32_t query) = 0;
+    virtual void BeginTimerQuery(uint32_t query) = 0;
+    virtual void EndTimerQuery() = 0;
+    // Never waits: false while the GPU has not reached the end of the query yet
+    virtual bool GetQueryResult(uint32_t query, uint64_t& outNanoseconds) = 0;
+
+    // Transform feedback: draws issued in between write the program's captured outputs instead of (or on top of,
+    // without rasterizer discard) rasterizing
+    virtual void BeginTransformFeedback(PrimitiveType primitive) = 0;
+    virtual void EndTransformFeedback() = 0;
+    virtual void SetRasterizerDiscard(bool enabled) = 0;
+
+    // Draws
+    virtual void DrawIndexed(PrimitiveType primitive, uint32_t indexCount) = 0;
+    virtual void DrawArraysInstanced(PrimitiveType primitive, uint32_t vertexCount, uint32_t instanceCount) = 0;
+
+    // Replaces the current backend, must happen before any GPU object is created
+    static void Create(API api);
+    static API GetAPI() { return s_API; }
+    static RendererAPI& Get() { return *s_Instance; }
+private:
+    static API s_API;
+    // Deliberately never destroyed: GPU objects owned by other statics may still release their handles at exit
+    static RendererAPI* s_Instance;
+};
@@ -1,138 +1,243 @@
 #include "Shader.h"
+#include "RendererAPI.h"
 
-#include <glad/glad.h>
 #include <glm/glm.hpp>
 
+#include <algorithm>
+#include <cstring>
 #include <iostream>
+#include <string>
+
+Shader::UploadStats Shader::s_UploadStats;
+
+namespace
+{
+    // FNV-1a
+    uint32_t HashName(const char* name)
+    {
+        uint32_t hash = 2166136261u;
+        for (; *name != '\0'; ++name)
+            hash = (hash ^ static_cast<unsigned char>(*name)) * 16777619u;
+        return hash;
+    }
+}
 
 Shader::Shader(const char* vertexSource, const char* fragmentSource, const char* geometrySource)
 {
     Compile(vertexSource, fragmentSource, geometrySource);
 }
 
+Shader::Shader(const char* vertexSource, const std::vector<const char*>& feedbackVaryings)
+{
+    m_ID = RendererAPI::Get().CreateFeedbackProgram(vertexSource, feedbackVaryings);
+    CacheUniformLocations();
+}
+
 void Shader::Use() const
 {
-    glUseProgram(m_ID);
+    RendererAPI::Get().UseProgram(m_ID);
+}
+
+UniformHandle Shader::GetUniformHandle(const char* name) const
+{
+    const uint32_t hash = HashName(name);
+    auto it = std::lower_bound(m_Uniforms.begin(), m_Uniforms.end(), hash,
+        [](const UniformEntry& entry, const uint32_t value) { return entry.NameHash < value; });
+
+    for (; it != m_Uniforms.end() && it->NameHash == hash; ++it)
+    {
+        if (it->Name == name)
+            return { static_cast<int>(it - m_Uniforms.begin()) };
+    }
+
+    // Typically a typo or a uniform the compiler optimized out, every upload to it would be lost
+    if (std::find(m_MissingNames.begin(), m_MissingNames.end(), hash) == m_MissingNames.end())
+    {
+        m_MissingNames.push_back(hash);
+        std::cout << "| [WARNING] Shader: Uniform '" << name << "' is not active in program " << m_ID << '\n';
+    }
+
+    return {};
+}
+
+void Shader::SetFloat(const char* name, const float value) const
+{
+    SetFloat(GetUniformHandle(name), value);
 }
 
-void Shader::SetFloat(const char* name, float value) const
+void Shader::SetInteger(const char* name, const int value) const
 {
-    glUniform1f(glGetUniformLocation(m_ID, name), value);
+    SetInteger(GetUniformHandle(name), value);
 }
 
-void Shader::SetInteger(const char* name, int value) const
+void Shader::SetBool(const char* name, const bool value) const
 {
-    glUniform1i(glGetUniformLocation(m_ID, name), value);
+    SetBool(GetUniformHandle(name), value);
 }
 
-void Shader::SetBool(const char* name, bool value) const
+void Shader::SetIntegerArray(const char* name, const int* values, const int count) const
 {
-    glUniform1i(glGetUniformLocation(m_ID, name), static_cast<int>(value));
+    SetIntegerArray(GetUniformHandle(name), values, count);
 }
 
-void Shader::SetVector2f(const char* name, float x, float y) const
+void Shader::SetVector2f(const char* name, const float x, const float y) const
 {
-    glUniform2f(glGetUniformLocation(m_ID, name), x, y);
+    SetVector2f(GetUniformHandle(name), glm::vec2(x, y));
 }
 
 void Shader::SetVector2f(const char* name, const glm::vec2& value) const
 {
-    glUniform2fv(glGetUniformLocation(m_ID, name), 1, &value[0]);
+    SetVector2f(GetUniformHandle(name), value);
 }
 
-void Shader::SetVector3f(const char* name, float x, float y, float z) const
+void Shader::SetVector3f(const char* name, const float x, const float y, const float z) const
 {
-    glUniform3f(glGetUniformLocation(m_ID, name), x, y, z);
+    SetVector3f(GetUniformHandle(name), glm::vec3(x, y, z));
 }
 
 void Shader::SetVector3f(const char* name, const glm::vec3& value) const
 {
-    glUniform3fv(glGetUniformLocation(m_ID, name), 1, &value[0]);
+    SetVector3f(GetUniformHandle(name), value);
 }
 
 void Shader::SetVector4f(const char* name, const float x, const float y, const float z, const float w) const
 {
-    glUniform4f(glGetUniformLocation(m_ID, name), x, y, z, w);
+    SetVector4f(GetUniformHandle(name), glm::vec4(x, y, z, w));
 }
 
 void Shader::SetVector4f(const char* name, const glm::vec4& value) const
 {
-    glUniform4fv(glGetUniformLocation(m_ID, name), 1, &value[0]);
+    SetVector4f(GetUniformHandle(name), value);
 }
 
 void Shader::SetMatrix4(const char* name, const glm::mat4& matrix) const
 {
-    glUniformMatrix4fv(glGetUniformLocation(m_ID, name), 1, GL_FALSE, &matrix[0][0]);
+    SetMatrix4(GetUniformHandle(name), matrix);
 }
 
-void Shader::Compile(const char* vertexSource, const char* fragmentSource, const char* geometrySource)
+void Shader::SetFloat(const UniformHandle uniform, const float value) const
 {
-    unsigned int geometryID = 0;
+    if (ShadowValue(uniform, &value, sizeof(value)))
+        RendererAPI::Get().SetUniform(GetLocation(uniform), UniformType::Float, 1, &value);
+}
 
-    // vertex Shader
-    unsigned int vertexID = glCreateShader(GL_VERTEX_SHADER);
-    glShaderSource(vertexID, 1, &vertexSource, nullptr);
-    glCompileShader(vertexID);
-    CheckCompileErrors(vertexID, "VERTEX");
+void Shader::SetInteger(const UniformHandle uniform, const int value) const
+{
+    if (ShadowValue(uniform, &value, sizeof(value)))
+        RendererAPI::Get().SetUniform(GetLocation(uniform), UniformType::Integer, 1, &value);
+}
 
-    // fragment Shader
-    unsigned int fragmentID = glCreateShader(GL_FRAGMENT_SHADER);
-    glShaderSource(fragmentID, 1, &fragmentSource, nullptr);
-    glCompileShader(fragmentID);
-    CheckCompileErrors(fragmentID, "FRAGMENT");
+void Shader::SetBool(const UniformHandle uniform, const bool value) const
+{
+    SetInteger(uniform, static_cast<int>(value));
+}
 
-    // if geometry shader source code is given, also compile geometry shader
-    if (geometrySource != nullptr)
-    {
-        geometryID = glCreateShader(GL_GEOMETRY_SHADER);
-        glShaderSource(geometryID, 1, &geometrySource, nullptr);
-        glCompileShader(geometryID);
-        CheckCompileErrors(geometryID, "GEOMETRY");
-    }
+void Shader::SetIntegerArray(const UniformHandle uniform, const int* values, const int count) const
+{
+    if (ShadowValue(uniform, values, static_cast<uint32_t>(count * sizeof(int))))
+        RendererAPI::Get().SetUniform(GetLocation(uniform), UniformType::Integer, count, values);
+}
 
-    // shader program
-    m_ID = glCreateProgram();
-    glAttachShader(m_ID, vertexID);
-    glAttachShader(m_ID, fragmentID);
+void Shader::SetVector2f(const UniformHandle uniform, const glm::vec2& value) const
+{
+    if (ShadowValue(uniform, &value[0], sizeof(value)))
+        RendererAPI::Get().SetUniform(GetLocation(uniform), UniformType::Vector2f, 1, &value[0]);
+}
+
+void Shader::SetVector3f(const UniformHandle uniform, const glm::vec3& value) const
+{
+    if (ShadowValue(uniform, &value[0], sizeof(value)))
+        RendererAPI::Get().SetUniform(GetLocation(uniform), UniformType::Vector3f, 1, &value[0]);
+}
 
-    if (geometrySource != nullptr)
-        glAttachShader(m_ID, geometryID);
+void Shader::SetVector4f(const UniformHandle uniform, const glm::vec4& value) const
+{
+    if (ShadowValue(uniform, &value[0], sizeof(value)))
+        RendererAPI::Get().SetUniform(GetLocation(uniform), UniformType::Vector4f, 1, &value[0]);
+}
 
-    glLinkProgram(m_ID);
-    CheckCompileErrors(m_ID, "PROGRAM");
+void Shader::SetMatrix4(const UniformHandle uniform, const glm::mat4& matrix) const
+{
+    if (ShadowValue(uniform, &matrix[0][0], sizeof(matrix)))
+        RendererAPI::Get().SetUniform(GetLocation(uniform), UniformType::Matrix4, 1, &matrix[0][0]);
+}
 
-    // delete the shaders as they're linked into our program now and no longer necessary
-    glDeleteShader(vertexID);
-    glDeleteShader(fragmentID);
+const Shader::UploadStats& Shader::GetUploadStats()
+{
+    return s_UploadStats;
+}
 
-    if (geometrySource != nullptr)
-        glDeleteShader(geometryID);
+void Shader::ResetUploadStats()
+{
+    s_UploadStats = UploadStats();
 }
 
-void Shader::CheckCompileErrors(const unsigned int id, const char* type)
+bool Shader::ShadowValue(const UniformHandle uniform, const void* value, const uint32_t size) const
 {
-    int success;
-    char infoLog[1024];
-    if (type != "PROGRAM")
+    if (!uniform.IsValid())
+        return false;
+
+    const UniformEntry& entry = m_Uniforms[uniform.Index];
+    unsigned char* shadow = &m_UniformValues[entry.ValueOffset];
+    const uint32_t bytes = std::min(size, entry.ValueSize);
+    uint32_t& knownBytes = m_KnownBytes[entry.Shadow];
+
+    if (entry.ShadowOffset + bytes <= knownBytes && std::memcmp(shadow, value, bytes) == 0)
     {
-        glGetShaderiv(id, GL_COMPILE_STATUS, &success);
-        if (!success)
-        {
-            glGetShaderInfoLog(id, 1024, nullptr, infoLog);
-            std::cout << "| [ERROR] Shader: Compile-time error: Type: " << type << '\n'
-                << infoLog << "\n -- --------------------------------------------------- -- "
-                << '\n';
-        }
+        s_UploadStats.Skipped++;
+        return false;
     }
-    else
+
+    // Known bytes stay a prefix: an element written past it only extends it once the bytes before are known too
+    std::memcpy(shadow, value, bytes);
+    if (entry.ShadowOffset <= knownBytes)
+        knownBytes = std::max(knownBytes, entry.ShadowOffset + bytes);
+    s_UploadStats.Issued++;
+    return true;
+}
+
+void Shader::Compile(const char* vertexSource, const char* fragmentSource, const char* geometrySource)
+{
+    m_ID = RendererAPI::Get().CreateProgram(vertexSource, fragmentSource, geometrySource);
+    CacheUniformLocations();
+}
+
+void Shader::CacheUniformLocations()
+{
+    m_Uniforms.clear();
+    uint32_t valueBytes = 0;
+
+    std::vector<ProgramUniform> uniforms;
+    RendererAPI::Get().GetProgramUniforms(m_ID, uniforms);
+
+    for (uint32_t shadow = 0; shadow < static_cast<uint32_t>(uniforms.size()); shadow++)
     {
-        glGetProgramiv(id, GL_LINK_STATUS, &success);
-        if (!success)
+        ProgramUniform& uniform = uniforms[shadow];
+
+        // Arrays are reported as "name[0]", register them under their plain name
+        std::string& uniformName = uniform.Name;
+        if (uniformName.size() > 3 && uniformName.compare(uniformName.size() - 3, 3, "[0]") == 0)
+            uniformName.resize(uniformName.size() - 3);
+
+        if (uniform.Count > 1)
         {
-            glGetProgramInfoLog(id, 1024, nullptr, infoLog);
-            std::cout << "| [ERROR] Shader: Link-time error: Type: " << type << '\n'
-                << infoLog << "\n -- --------------------------------------------------- -- "
-                << '\n';
+            // Each element under "name[i]" too, sharing the array's shadow
+            const uint32_t elementSize = uniform.Size / uniform.Count;
+            for (uint32_t i = 0; i < uniform.Count; i++)
+            {
+                const std::string elementName = uniformName + "[" + std::to_string(i) + "]";
+                m_Uniforms.push_back({ HashName(elementName.c_str()), uniform.Location + static_cast<int>(i), valueBytes + i * elementSize,
+                    uniform.Size - i * elementSize, shadow, i * elementSize, elementName });
+            }
         }
+
+        m_Uniforms.push_back({ HashName(uniformName.c_str()), uniform.Location, valueBytes, uniform.Size, shadow, 0, std::move(uniformName) });
+        valueBytes += uniform.Size;
     }
+
+    m_UniformValues.assign(valueBytes, 0);
+    m_KnownBytes.assign(uniforms.size(), 0);
+
+    std::sort(m_Uniforms.begin(), m_Uniforms.end(),
+        [](const UniformEntry& a, const UniformEntry& b) { return a.NameHash < b.NameHash; });
 }
@@ -1,18 +1,44 @@
 #pragma once
 
+#include <cstdint>
+#include <string>
+#include <vector>
+
 #include <glm/glm.hpp>
 
+// Pre-resolved uniform, lets hot paths skip the name lookup entirely
+struct UniformHandle
+{
+    int Index = -1;
+
+    bool IsValid() const { return Index >= 0; }
+};
+
 class Shader
 {
 public:
+    // Uniform uploads across every shader, setters called with the value a uniform already holds are skipped
+    struct UploadStats
+    {
+        uint32_t Issued = 0;
+        uint32_t Skipped = 0;
+    };
+
     Shader(const char* vertexSource, const char* fragmentSource, const char* geometrySource = nullptr);
+    // Transform feedback program, see RendererAPI::CreateFeedbackProgram
+    Shader(const char* vertexSource, const std::vector<const char*>& feedbackVaryings);
     ~Shader() = default;
 
     void Use() const;
 
+    // Returns an invalid handle if the uniform is not active in the program (setters then do nothing), reported once
+    // per name. Array elements resolve as "name[i]", setting them from element i onwards.
+    UniformHandle GetUniformHandle(const char* name) const;
+
     void SetFloat(const char* name, float value) const;
     void SetInteger(const char* name, int value) const;
     void SetBool(const char* name, bool value) const;
+    void SetIntegerArray(const char* name, const int* values, int count) const;
     void SetVector2f(const char* name, float x, float y) const;
     void SetVector2f(const char* name, const glm::vec2& value) const;
     void SetVector3f(const char* name, float x, float y, float z) const;
@@ -21,10 +47,50 @@ public:
     void SetVector4f(const char* name, const glm::vec4& value) const;
     void SetMatrix4(const char* name, const glm::mat4& matrix) const;
 
+    void SetFloat(UniformHandle uniform, float value) const;
+    void SetInteger(UniformHandle uniform, int value) const;
+    void SetBool(UniformHandle uniform, bool value) const;
+    void SetIntegerArray(UniformHandle uniform, const int* values, int count) const;
+    void SetVector2f(UniformHandle uniform, const glm::vec2& value) const;
+    void SetVector3f(UniformHandle uniform, const glm::vec3& value) const;
+    void SetVector4f(UniformHandle uniform, const glm::vec4& value) const;
+    void SetMatrix4(UniformHandle uniform, const glm::mat4& matrix) const;
+
     const unsigned int& GetID() const { return m_ID; }
+
+    static const UploadStats& GetUploadStats();
+    static void ResetUploadStats();
 private:
     void Compile(const char* vertexSource, const char* fragmentSource, const char* geometrySource = nullptr);
-    static void CheckCompileErrors(unsigned int id, const char* type);
+    void CacheUniformLocations();
+    // Compares the value against the last one uploaded, returns true (and records it) if it changed or was never
+    // uploaded
+    bool ShadowValue(UniformHandle uniform, const void* value, uint32_t size) const;
+    int GetLocation(UniformHandle uniform) const { return m_Uniforms[uniform.Index].Location; }
 private:
+    struct UniformEntry
+    {
+        uint32_t NameHash;
+        int Location;
+        uint32_t ValueOffset;
+        // Bytes from this entry to the end of its uniform (the rest of the array for an element)
+        uint32_t ValueSize;
+        // An array and its elements share one shadow: its index in m_KnownBytes, and the element's offset in it
+        uint32_t Shadow;
+        uint32_t ShadowOffset;
+        std::string Name;
+    };
+
     unsigned int m_ID;
-};
\ No newline at end of file
+    // Active uniforms (and every element of the arrays) sorted by name hash, looked up without any allocation
+    std::vector<UniformEntry> m_Uniforms;
+    // Last value uploaded for each uniform
+    mutable std::vector<unsigned char> m_UniformValues;
+    // Leading bytes of each uniform's shadow known to match the program: none until the first upload, the program's
+    // own values (initializers, state restored from a cached binary) are never assumed
+    mutable std::vector<uint32_t> m_KnownBytes;
+    // Hashes of the names already reported as not active
+    mutable std::vector<uint32_t> m_MissingNames;
+
+    static UploadStats s_UploadStats;
+};
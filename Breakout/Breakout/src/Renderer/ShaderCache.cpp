@@ -0,0 +1,225 @@
+#include "ShaderCache.h"
+
+#include <glad/glad.h>
+
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+// GL_ARB_get_program_binary is not part of the generated GL 3.3 loader
+#define GL_PROGRAM_BINARY_RETRIEVABLE_HINT 0x8257
+#define GL_PROGRAM_BINARY_LENGTH 0x8741
+#define GL_NUM_PROGRAM_BINARY_FORMATS 0x87FE
+
+typedef void (APIENTRYP PFNGLGETPROGRAMBINARYPROC)(GLuint program, GLsizei bufSize, GLsizei* length, GLenum* binaryFormat, void* binary);
+typedef void (APIENTRYP PFNGLPROGRAMBINARYPROC)(GLuint program, GLenum binaryFormat, const void* binary, GLsizei length);
+typedef void (APIENTRYP PFNGLPROGRAMPARAMETERIPROC)(GLuint program, GLenum pname, GLint value);
+
+namespace
+{
+    constexpr uint32_t EntryMagic = 0x43534f42; // "BOSC"
+    constexpr uint32_t EntryVersion = 1;
+
+    struct EntryHeader
+    {
+        uint32_t Magic;
+        uint32_t Version;
+        uint64_t Key;
+        uint32_t BinaryFormat;
+        uint32_t BinaryLength;
+    };
+
+    struct CacheData
+    {
+        bool Enabled = false;
+        std::string Directory;
+        std::string DriverIdentity;
+
+        PFNGLGETPROGRAMBINARYPROC GetProgramBinary = nullptr;
+        PFNGLPROGRAMBINARYPROC ProgramBinary = nullptr;
+        PFNGLPROGRAMPARAMETERIPROC ProgramParameteri = nullptr;
+
+        ShaderCache::Statistics Stats;
+    };
+
+    CacheData s_Cache;
+
+    // FNV-1a, 64 bits
+    uint64_t Hash(uint64_t hash, const char* data, const size_t size)
+    {
+        for (size_t i = 0; i < size; i++)
+            hash = (hash ^ static_cast<unsigned char>(data[i])) * 1099511628211ull;
+        return hash;
+    }
+
+    uint64_t Hash(const uint64_t hash, const char* text)
+    {
+        // The terminating null is hashed too, so that ("ab", "c") and ("a", "bc") differ
+        return text != nullptr ? Hash(hash, text, std::strlen(text) + 1) : Hash(hash, "", 1);
+    }
+
+    bool HasExtension(const char* name)
+    {
+        int extensionCount = 0;
+        glGetIntegerv(GL_NUM_EXTENSIONS, &extensionCount);
+        for (int i = 0; i < extensionCount; i++)
+        {
+            const auto extension = reinterpret_cast<const char*>(glGetStringi(GL_EXTENSIONS, static_cast<unsigned int>(i)));
+            if (extension != nullptr && std::strcmp(extension, name) == 0)
+                return true;
+        }
+        return false;
+    }
+}
+
+void ShaderCache::Initialize(const std::string& directory, const ProcLoader loader)
+{
+    s_Cache = CacheData();
+
+    int major = 0, minor = 0;
+    glGetIntegerv(GL_MAJOR_VERSION, &major);
+    glGetIntegerv(GL_MINOR_VERSION, &minor);
+    if (major * 10 + minor < 41 && !HasExtension("GL_ARB_get_program_binary"))
+    {
+        std::cout << "| [INFO] ShaderCache: Program binaries are not supported by the driver, cache disabled" << '\n';
+        return;
+    }
+
+    s_Cache.GetProgramBinary = reinterpret_cast<PFNGLGETPROGRAMBINARYPROC>(loader("glGetProgramBinary"));
+    s_Cache.ProgramBinary = reinterpret_cast<PFNGLPROGRAMBINARYPROC>(loader("glProgramBinary"));
+    s_Cache.ProgramParameteri = reinterpret_cast<PFNGLPROGRAMPARAMETERIPROC>(loader("glProgramParameteri"));
+
+    int formatCount = 0;
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formatCount);
+    if (s_Cache.GetProgramBinary == nullptr || s_Cache.ProgramBinary == nullptr || s_Cache.ProgramParameteri == nullptr || formatCount == 0)
+    {
+        std::cout << "| [INFO] ShaderCache: No program binary format available, cache disabled" << '\n';
+        return;
+    }
+
+    std::error_code error;
+    std::filesystem::create_directories(directory, error);
+    if (error)
+    {
+        std::cout << "| [WARNING] ShaderCache: Failed to create cache directory '" << directory << "'. Error: " << error.message() << '\n';
+        return;
+    }
+
+    s_Cache.Directory = directory;
+    s_Cache.DriverIdentity = std::string(reinterpret_cast<const char*>(glGetString(GL_VENDOR))) + '|'
+        + reinterpret_cast<const char*>(glGetString(GL_RENDERER)) + '|'
+        + reinterpret_cast<const char*>(glGetString(GL_VERSION));
+    s_Cache.Enabled = true;
+}
+
+bool ShaderCache::IsEnabled()
+{
+    return s_Cache.Enabled;
+}
+
+uint64_t ShaderCache::ComputeKey(const char* vertexSource, const char* fragmentSource, const char* geometrySource,
+                                 const char* feedbackVaryings /* = nullptr */)
+{
+    uint64_t key = 14695981039346656037ull;
+    key = Hash(key, s_Cache.DriverIdentity.c_str());
+    key = Hash(key, vertexSource);
+    key = Hash(key, fragmentSource);
+    key = Hash(key, geometrySource);
+    // Only hashed when present, keys of regular programs stay what they were
+    if (feedbackVaryings != nullptr)
+        key = Hash(key, feedbackVaryings);
+    return key;
+}
+
+void ShaderCache::PrepareProgram(const unsigned int program)
+{
+    if (s_Cache.Enabled)
+        s_Cache.ProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+}
+
+bool ShaderCache::Load(const uint64_t key, const unsigned int program)
+{
+    if (!s_Cache.Enabled)
+        return false;
+
+    std::ifstream file(GetEntryPath(key), std::ios::binary);
+    if (!file)
+        return false;
+
+    EntryHeader header{};
+    file.read(reinterpret_cast<char*>(&header), sizeof(header));
+    if (!file || header.Magic != EntryMagic || header.Version != EntryVersion || header.Key != key || header.BinaryLength == 0)
+        return false;
+
+    std::vector<char> binary(header.BinaryLength);
+    file.read(binary.data(), header.BinaryLength);
+    if (!file)
+        return false;
+
+    // The driver is free to reject a binary (e.g. after an update it does not report in its version string)
+    s_Cache.ProgramBinary(program, header.BinaryFormat, binary.data(), static_cast<int>(header.BinaryLength));
+    int success = 0;
+    glGetProgramiv(program, GL_LINK_STATUS, &success);
+    return success != 0;
+}
+
+void ShaderCache::Store(const uint64_t key, const unsigned int program)
+{
+    if (!s_Cache.Enabled)
+        return;
+
+    int length = 0;
+    glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0)
+        return;
+
+    std::vector<char> binary(length);
+    GLenum format = 0;
+    s_Cache.GetProgramBinary(program, length, &length, &format, binary.data());
+
+    const EntryHeader header{ EntryMagic, EntryVersion, key, format, static_cast<uint32_t>(length) };
+
+    // Written to a temporary file first so that a crash never leaves a truncated entry behind
+    const std::string path = GetEntryPath(key);
+    const std::string temporaryPath = path + ".tmp";
+    {
+        std::ofstream file(temporaryPath, std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(binary.data(), length);
+        if (!file)
+        {
+            std::cout << "| [WARNING] ShaderCache: Failed to write '" << temporaryPath << "'" << '\n';
+            return;
+        }
+    }
+
+    std::error_code error;
+    std::filesystem::rename(temporaryPath, path, error);
+}
+
+void ShaderCache::RecordLoad(const double milliseconds)
+{
+    s_Cache.Stats.Hits++;
+    s_Cache.Stats.LoadMilliseconds += milliseconds;
+}
+
+void ShaderCache::RecordCompile(const double milliseconds)
+{
+    s_Cache.Stats.Misses++;
+    s_Cache.Stats.CompileMilliseconds += milliseconds;
+}
+
+const ShaderCache::Statistics& ShaderCache::GetStats()
+{
+    return s_Cache.Stats;
+}
+
+std::string ShaderCache::GetEntryPath(const uint64_t key)
+{
+    char name[32];
+    std::snprintf(name, sizeof(name), "%016llx.bin", static_cast<unsigned long long>(key));
+    return (std::filesystem::path(s_Cache.Directory) / name).string();
+}
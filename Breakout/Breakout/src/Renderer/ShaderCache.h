@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+// On-disk cache of linked program binaries (GL_ARB_get_program_binary, core since 4.1).
+// Entries are keyed by a hash of the shader sources and of the driver vendor/renderer/version strings,
+// so a driver update or a source edit simply misses and falls back to compiling from source.
+class ShaderCache
+{
+public:
+    using ProcLoader = void* (*)(const char* name);
+
+    struct Statistics
+    {
+        uint32_t Hits = 0;
+        uint32_t Misses = 0;
+        double LoadMilliseconds = 0.0;    // programs restored from the cache
+        double CompileMilliseconds = 0.0; // programs compiled and linked from source
+    };
+
+    // The entry points are not part of the GL 3.3 loader, hence the proc loader. Leaves the cache disabled
+    // when the driver does not support program binaries.
+    static void Initialize(const std::string& directory, ProcLoader loader);
+    static bool IsEnabled();
+
+    // feedbackVaryings: names of the captured outputs of a transform feedback program, one per line
+    static uint64_t ComputeKey(const char* vertexSource, const char* fragmentSource, const char* geometrySource, const char* feedbackVaryings = nullptr);
+
+    // Must be called before linking a program that will be stored
+    static void PrepareProgram(unsigned int program);
+    static bool Load(uint64_t key, unsigned int program);
+    static void Store(uint64_t key, unsigned int program);
+
+    static void RecordLoad(double milliseconds);
+    static void RecordCompile(double milliseconds);
+    static const Statistics& GetStats();
+private:
+    static std::string GetEntryPath(uint64_t key);
+};
@@ -1,38 +1,38 @@
 ﻿#include "Texture2D.h"
 
-#include <glad/glad.h>
-
 Texture2D::Texture2D(const int width, const int height, const int nbChannels)
     : m_ID(0), m_Width(width), m_Height(height), m_Channels(nbChannels)
 {
-    glGenTextures(1, &m_ID);
+    m_ID = RendererAPI::Get().CreateTexture();
 }
 
 void Texture2D::Bind(const unsigned int slot) const
 {
     // Bind the texture to the specified slot
-    glActiveTexture(GL_TEXTURE0 + slot);
-    glBindTexture(GL_TEXTURE_2D, m_ID);
+    RendererAPI::Get().BindTexture(slot, m_ID);
 }
 
 void Texture2D::Unbind() const
 {
-    glBindTexture(GL_TEXTURE_2D, 0);
+    RendererAPI::Get().BindTexture(0, 0);
+}
+
+void Texture2D::SetData(const void* data, const TextureFormat format, const PixelType type) const
+{
+    RendererAPI::Get().SetTextureData(m_Width, m_Height, format, type, data);
 }
 
-void Texture2D::SetData(const void* data, int internalFormat, unsigned int dataFormat, unsigned int type) const
+void Texture2D::SetSubData(const void* data, const int x, const int y, const int width, const int height, const TextureFormat format, const PixelType type) const
 {
-    glTexImage2D(GL_TEXTURE_2D, 0, internalFormat, m_Width, m_Height, 0, dataFormat, type, data);
+    RendererAPI::Get().SetTextureSubData(x, y, width, height, format, type, data);
 }
 
-void Texture2D::SetFilterMode(const int mode)
+void Texture2D::SetFilterMode(const TextureFilter filter)
 {
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, mode);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, mode);
+    RendererAPI::Get().SetTextureFilter(filter);
 }
 
-void Texture2D::SetWrapMode(const int mode)
+void Texture2D::SetWrapMode(const TextureWrap wrap)
 {
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, mode);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, mode);
+    RendererAPI::Get().SetTextureWrap(wrap);
 }
@@ -1,5 +1,7 @@
 ﻿#pragma once
 
+#include "RendererAPI.h"
+
 class Texture2D
 {
 public:
@@ -9,10 +11,12 @@ public:
     void Bind(unsigned int slot = 0) const;
     void Unbind() const;
 
-    void SetData(const void* data, int internalFormat, unsigned int dataFormat, unsigned int type) const;
+    void SetData(const void* data, TextureFormat format, PixelType type) const;
+    // Updates a sub-rectangle of the (already allocated) texture, data is a byte offset when a pixel unpack buffer is bound
+    void SetSubData(const void* data, int x, int y, int width, int height, TextureFormat format, PixelType type) const;
 
-    void SetFilterMode(int mode);
-    void SetWrapMode(int mode);
+    void SetFilterMode(TextureFilter filter);
+    void SetWrapMode(TextureWrap wrap);
 
     const unsigned int& GetID() const { return m_ID; }
     unsigned int GetWidth() const { return m_Width; }
@@ -0,0 +1,260 @@
+#include "TextureAtlas.h"
+#include "RendererAPI.h"
+
+#include <algorithm>
+#include <climits>
+#include <cstring>
+#include <iostream>
+
+namespace
+{
+    // Skyline bottom-left: the packed area is described by its top outline, each new rectangle goes where
+    // its top edge ends up lowest (ties broken by leftmost position)
+    class SkylinePacker
+    {
+    public:
+        explicit SkylinePacker(const int size)
+            : m_Size(size)
+        {
+            m_Skyline.push_back({ 0, 0, size });
+        }
+
+        bool Insert(const int width, const int height, int& outX, int& outY)
+        {
+            int bestIndex = -1, bestX = 0, bestY = 0, bestTop = INT_MAX;
+            for (size_t i = 0; i < m_Skyline.size(); i++)
+            {
+                int y;
+                if (!Fits(i, width, height, y))
+                    continue;
+
+                if (y + height < bestTop || (y + height == bestTop && m_Skyline[i].X < bestX))
+                {
+                    bestIndex = static_cast<int>(i);
+                    bestX = m_Skyline[i].X;
+                    bestY = y;
+                    bestTop = y + height;
+                }
+            }
+
+            if (bestIndex < 0)
+                return false;
+
+            AddSegment(static_cast<size_t>(bestIndex), bestX, bestY + height, width);
+            outX = bestX;
+            outY = bestY;
+            return true;
+        }
+    private:
+        struct Segment
+        {
+            int X, Y, Width;
+        };
+
+        // Height at which a rectangle starting at segment 'index' rests on the skyline
+        bool Fits(size_t index, const int width, const int height, int& outY) const
+        {
+            const int x = m_Skyline[index].X;
+            if (x + width > m_Size)
+                return false;
+
+            int remaining = width;
+            outY = 0;
+            for (; remaining > 0; index++)
+            {
+                outY = std::max(outY, m_Skyline[index].Y);
+                if (outY + height > m_Size)
+                    return false;
+                remaining -= m_Skyline[index].Width;
+            }
+            return true;
+        }
+
+        void AddSegment(const size_t index, const int x, const int y, const int width)
+        {
+            m_Skyline.insert(m_Skyline.begin() + static_cast<std::ptrdiff_t>(index), { x, y, width });
+
+            // Trim or remove the segments now covered by the new one
+            for (size_t i = index + 1; i < m_Skyline.size();)
+            {
+                Segment& segment = m_Skyline[i];
+                const int overlap = x + width - segment.X;
+                if (overlap <= 0)
+                    break;
+
+                if (overlap < segment.Width)
+                {
+                    segment.X += overlap;
+                    segment.Width -= overlap;
+                    break;
+                }
+                m_Skyline.erase(m_Skyline.begin() + static_cast<std::ptrdiff_t>(i));
+            }
+
+            // Merge neighbours at the same height
+            for (size_t i = 0; i + 1 < m_Skyline.size();)
+            {
+                if (m_Skyline[i].Y == m_Skyline[i + 1].Y)
+                {
+                    m_Skyline[i].Width += m_Skyline[i + 1].Width;
+                    m_Skyline.erase(m_Skyline.begin() + static_cast<std::ptrdiff_t>(i + 1));
+                }
+                else
+                {
+                    i++;
+                }
+            }
+        }
+    private:
+        int m_Size;
+        std::vector<Segment> m_Skyline;
+    };
+}
+
+TextureAtlas::TextureAtlas(const int pageSize /* = 2048 */, const int padding /* = 1 */)
+    : m_PageSize(pageSize), m_Padding(padding)
+{
+}
+
+TextureAtlas::~TextureAtlas()
+{
+    for (const auto& page : m_Pages)
+        RendererAPI::Get().DeleteTexture(page->GetID());
+}
+
+void TextureAtlas::Add(const std::string& name, const unsigned char* pixels, const int width, const int height, const int channels)
+{
+    Image image{ name, width, height, std::vector<unsigned char>(static_cast<size_t>(width) * height * 4) };
+
+    for (int i = 0; i < width * height; i++)
+    {
+        const unsigned char* source = pixels + static_cast<size_t>(i) * channels;
+        unsigned char* destination = &image.Pixels[static_cast<size_t>(i) * 4];
+        switch (channels)
+        {
+            case 1:
+                destination[0] = destination[1] = destination[2] = source[0];
+                destination[3] = 255;
+                break;
+            case 2:
+                destination[0] = destination[1] = destination[2] = source[0];
+                destination[3] = source[1];
+                break;
+            case 3:
+                std::memcpy(destination, source, 3);
+                destination[3] = 255;
+                break;
+            default:
+                std::memcpy(destination, source, 4);
+                break;
+        }
+    }
+
+    m_Images.push_back(std::move(image));
+}
+
+bool TextureAtlas::Build()
+{
+    for (const Image& image : m_Images)
+    {
+        if (image.Width <= 0 || image.Height <= 0 || image.Width + 2 * m_Padding > m_PageSize || image.Height + 2 * m_Padding > m_PageSize)
+        {
+            std::cout << "[ERROR] TextureAtlas: Image '" << image.Name << "' (" << image.Width << "x" << image.Height
+                << ") does not fit in a " << m_PageSize << "x" << m_PageSize << " page" << '\n';
+            return false;
+        }
+    }
+
+    // Tallest first packs best with a skyline, the name makes the order (and so the layout) deterministic
+    std::vector<const Image*> order;
+    order.reserve(m_Images.size());
+    for (const Image& image : m_Images)
+        order.push_back(&image);
+
+    std::sort(order.begin(), order.end(), [](const Image* a, const Image* b)
+    {
+        if (a->Height != b->Height)
+            return a->Height > b->Height;
+        if (a->Width != b->Width)
+            return a->Width > b->Width;
+        return a->Name < b->Name;
+    });
+
+    std::unordered_map<std::string, Region> regions;
+    std::vector<SkylinePacker> packers;
+    std::vector<std::vector<unsigned char>> pagePixels;
+    const size_t pageBytes = static_cast<size_t>(m_PageSize) * m_PageSize * 4;
+
+    for (const Image* image : order)
+    {
+        const int paddedWidth = image->Width + 2 * m_Padding;
+        const int paddedHeight = image->Height + 2 * m_Padding;
+
+        // First page with room for it, or a new one
+        int x = 0, y = 0;
+        uint32_t page = 0;
+        while (page < packers.size() && !packers[page].Insert(paddedWidth, paddedHeight, x, y))
+            page++;
+
+        if (page == packers.size())
+        {
+            packers.emplace_back(m_PageSize);
+            pagePixels.emplace_back(pageBytes, 0);
+            packers.back().Insert(paddedWidth, paddedHeight, x, y);
+        }
+
+        // Copy the image, extruding its border into the padding so linear filtering never bleeds neighbours in
+        unsigned char* destination = pagePixels[page].data();
+        for (int row = -m_Padding; row < image->Height + m_Padding; row++)
+        {
+            const int sourceRow = std::clamp(row, 0, image->Height - 1);
+            for (int column = -m_Padding; column < image->Width + m_Padding; column++)
+            {
+                const int sourceColumn = std::clamp(column, 0, image->Width - 1);
+                const size_t sourceOffset = (static_cast<size_t>(sourceRow) * image->Width + sourceColumn) * 4;
+                const size_t destinationOffset = (static_cast<size_t>(y + m_Padding + row) * m_PageSize + (x + m_Padding + column)) * 4;
+                std::memcpy(destination + destinationOffset, &image->Pixels[sourceOffset], 4);
+            }
+        }
+
+        Region region;
+        region.Page = page;
+        region.X = x + m_Padding;
+        region.Y = y + m_Padding;
+        region.Width = image->Width;
+        region.Height = image->Height;
+        const auto size = static_cast<float>(m_PageSize);
+        region.UVRect = glm::vec4(region.X / size, region.Y / size, (region.X + region.Width) / size, (region.Y + region.Height) / size);
+        regions[image->Name] = region;
+    }
+
+    for (const auto& page : m_Pages)
+        RendererAPI::Get().DeleteTexture(page->GetID());
+    m_Pages.clear();
+
+    for (const auto& pixels : pagePixels)
+    {
+        auto texture = std::make_unique<Texture2D>(m_PageSize, m_PageSize, 4);
+        texture->Bind();
+        texture->SetData(pixels.data(), TextureFormat::RGBA, PixelType::UnsignedByte);
+        texture->SetFilterMode(TextureFilter::Linear);
+        texture->SetWrapMode(TextureWrap::ClampToEdge);
+        m_Pages.push_back(std::move(texture));
+    }
+
+    m_Regions = std::move(regions);
+    for (auto& it : m_Regions)
+        it.second.Texture = m_Pages[it.second.Page].get();
+
+    // The pages hold everything now
+    m_Images.clear();
+    m_Images.shrink_to_fit();
+
+    return true;
+}
+
+const TextureAtlas::Region* TextureAtlas::GetRegion(const std::string& name) const
+{
+    const auto it = m_Regions.find(name);
+    return it != m_Regions.end() ? &it->second : nullptr;
+}
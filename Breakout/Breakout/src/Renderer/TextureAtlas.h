@@ -0,0 +1,55 @@
+#pragma once
+
+#include "Texture2D.h"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+// Packs many small images into a few large RGBA pages (skyline bottom-left packer) so that whole
+// levels can be drawn with a single texture binding. Regions are handed to Renderer::Submit or to
+// InstanceBuffer instances through their page texture and UV rectangle.
+class TextureAtlas
+{
+public:
+    struct Region
+    {
+        const Texture2D* Texture = nullptr;
+        glm::vec4 UVRect = glm::vec4(0.0f, 0.0f, 1.0f, 1.0f); // (u0, v0, u1, v1)
+        uint32_t Page = 0;
+        int X = 0, Y = 0, Width = 0, Height = 0;            // in page texels
+    };
+
+    explicit TextureAtlas(int pageSize = 2048, int padding = 1);
+    TextureAtlas(const TextureAtlas& other) = delete;
+    ~TextureAtlas();
+
+    // Pixels are copied (and expanded to RGBA), rows in the same order as they will appear in the texture
+    void Add(const std::string& name, const unsigned char* pixels, int width, int height, int channels);
+    // Packs every added image and uploads the pages, then releases the CPU copies. The layout only depends
+    // on the set of images, not on the order they were added in. Returns false if an image is empty or does not fit in a
+    // page, every image is checked first so the atlas then keeps its previous pages and regions.
+    bool Build();
+
+    const Region* GetRegion(const std::string& name) const;
+    uint32_t GetPageCount() const { return static_cast<uint32_t>(m_Pages.size()); }
+    const Texture2D& GetPage(uint32_t index) const { return *m_Pages[index]; }
+private:
+    struct Image
+    {
+        std::string Name;
+        int Width, Height;
+        std::vector<unsigned char> Pixels; // RGBA
+    };
+
+    int m_PageSize;
+    int m_Padding;
+
+    std::vector<Image> m_Images;
+    std::vector<std::unique_ptr<Texture2D>> m_Pages;
+    std::unordered_map<std::string, Region> m_Regions;
+};
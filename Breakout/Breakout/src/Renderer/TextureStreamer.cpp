@@ -0,0 +1,104 @@
+#include "TextureStreamer.h"
+
+#include "RendererAPI.h"
+#include "Texture2D.h"
+
+#include <chrono>
+#include <cstring>
+
+namespace
+{
+    double MillisecondsSince(const std::chrono::steady_clock::time_point start)
+    {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+}
+
+TextureStreamer::TextureStreamer(const uint32_t bufferCount /* = 3 */)
+    : m_Buffers(bufferCount > 0 ? bufferCount : 1)
+{
+    for (PixelBuffer& buffer : m_Buffers)
+        buffer.ID = RendererAPI::Get().CreateBuffer();
+}
+
+TextureStreamer::~TextureStreamer()
+{
+    for (PixelBuffer& buffer : m_Buffers)
+        RendererAPI::Get().DeleteBuffer(buffer.ID);
+}
+
+void TextureStreamer::Upload(const Texture2D& texture, const void* data, const int x, const int y, const int width, const int height,
+                             const TextureFormat format, const PixelType type)
+{
+    void* mapping = BeginUpload(width, height, format, type);
+    if (mapping == nullptr)
+        return;
+
+    const auto startTime = std::chrono::steady_clock::now();
+    std::memcpy(mapping, data, m_MappedSize);
+    m_MapMilliseconds += MillisecondsSince(startTime);
+
+    EndUpload(texture, x, y, width, height, format, type);
+}
+
+void* TextureStreamer::BeginUpload(const int width, const int height, const TextureFormat format, const PixelType type)
+{
+    const auto startTime = std::chrono::steady_clock::now();
+
+    PixelBuffer& buffer = m_Buffers[m_NextBuffer];
+    m_MappedSize = static_cast<uint32_t>(width * height) * GetPixelSize(format, type);
+
+    RendererAPI& api = RendererAPI::Get();
+    api.BindBuffer(BufferTarget::PixelUnpack, buffer.ID);
+
+    // Orphan the previous storage: if the GPU is still reading from it, the driver hands us a fresh block
+    // instead of waiting for the transfer to finish
+    if (m_MappedSize > buffer.Capacity)
+        buffer.Capacity = m_MappedSize;
+    api.SetBufferData(BufferTarget::PixelUnpack, buffer.Capacity, nullptr, BufferUsage::Stream);
+
+    void* mapping = api.MapBuffer(BufferTarget::PixelUnpack, m_MappedSize);
+    if (mapping == nullptr)
+        api.BindBuffer(BufferTarget::PixelUnpack, 0);
+
+    m_MapMilliseconds = MillisecondsSince(startTime);
+    return mapping;
+}
+
+void TextureStreamer::EndUpload(const Texture2D& texture, const int x, const int y, const int width, const int height,
+                                const TextureFormat format, const PixelType type)
+{
+    const auto startTime = std::chrono::steady_clock::now();
+
+    RendererAPI& api = RendererAPI::Get();
+    api.UnmapBuffer(BufferTarget::PixelUnpack);
+
+    // Sourced from the bound unpack buffer, the pointer is an offset into it
+    api.SetUnpackAlignment(1);
+    texture.Bind();
+    texture.SetSubData(nullptr, x, y, width, height, format, type);
+    api.SetUnpackAlignment(4);
+
+    api.BindBuffer(BufferTarget::PixelUnpack, 0);
+    m_NextBuffer = (m_NextBuffer + 1) % static_cast<uint32_t>(m_Buffers.size());
+
+    m_Stats.Uploads++;
+    m_Stats.Bytes += m_MappedSize;
+    m_Stats.Milliseconds += m_MapMilliseconds + MillisecondsSince(startTime);
+}
+
+uint32_t TextureStreamer::GetPixelSize(const TextureFormat format, const PixelType type)
+{
+    const uint32_t components = static_cast<uint32_t>(format) + 1;
+
+    switch (type)
+    {
+        case PixelType::UnsignedShort:
+        case PixelType::HalfFloat:
+            return components * 2;
+        case PixelType::Float:
+            return components * 4;
+        default:
+            return components;
+    }
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include "RendererAPI.h"
+
+#include <cstdint>
+#include <vector>
+
+class Texture2D;
+
+// Streams texel data to textures through a ring of pixel unpack buffers (PBOs).
+// The CPU writes into a freshly orphaned buffer and glTexSubImage2D sources from it, so the copy to
+// the texture becomes an asynchronous transfer instead of a blocking one from client memory.
+// Meant for textures updated every frame: scrolling backgrounds, minimaps, CPU-generated effects.
+class TextureStreamer
+{
+public:
+    struct Statistics
+    {
+        uint32_t Uploads = 0;
+        uint64_t Bytes = 0;
+        double Milliseconds = 0.0; // CPU time spent mapping, copying and issuing the transfers
+
+        double GetMegabytesPerSecond() const { return Milliseconds > 0.0 ? static_cast<double>(Bytes) / (Milliseconds * 1000.0) : 0.0; }
+    };
+
+    explicit TextureStreamer(uint32_t bufferCount = 3);
+    TextureStreamer(const TextureStreamer& other) = delete;
+    ~TextureStreamer();
+
+    // Copies the given pixels into the texture's (x, y, width, height) rectangle, rows are tightly packed
+    void Upload(const Texture2D& texture, const void* data, int x, int y, int width, int height, TextureFormat format, PixelType type);
+
+    // Zero-copy variant: write the pixels straight into the returned mapping, then call EndUpload
+    void* BeginUpload(int width, int height, TextureFormat format, PixelType type);
+    void EndUpload(const Texture2D& texture, int x, int y, int width, int height, TextureFormat format, PixelType type);
+
+    uint32_t GetBufferCount() const { return static_cast<uint32_t>(m_Buffers.size()); }
+    const Statistics& GetStats() const { return m_Stats; }
+    void ResetStats() { m_Stats = Statistics(); }
+
+    static uint32_t GetPixelSize(TextureFormat format, PixelType type);
+private:
+    struct PixelBuffer
+    {
+        unsigned int ID = 0;
+        uint32_t Capacity = 0;
+    };
+
+    std::vector<PixelBuffer> m_Buffers;
+    uint32_t m_NextBuffer = 0;
+    uint32_t m_MappedSize = 0;
+    double m_MapMilliseconds = 0.0;
+
+    Statistics m_Stats;
+};
@@ -0,0 +1,59 @@
+#include "UniformBuffer.h"
+
+#include "RendererAPI.h"
+
+#include <cstring>
+#include <iostream>
+
+namespace
+{
+    struct BlockBinding
+    {
+        const char* Name;
+        UniformBinding Binding;
+    };
+
+    constexpr BlockBinding s_BlockBindings[] = {
+        { "FrameData", UniformBinding::Frame },
+    };
+}
+
+UniformBuffer::UniformBuffer(const uint32_t size, const UniformBinding binding)
+    : m_Size(size), m_Binding(binding)
+{
+    RendererAPI& api = RendererAPI::Get();
+    m_ID = api.CreateBuffer();
+    api.BindBuffer(BufferTarget::Uniform, m_ID);
+    api.SetBufferData(BufferTarget::Uniform, size, nullptr, BufferUsage::Dynamic);
+    api.BindBufferBase(BufferTarget::Uniform, static_cast<uint32_t>(binding), m_ID);
+}
+
+UniformBuffer::~UniformBuffer()
+{
+    RendererAPI::Get().DeleteBuffer(m_ID);
+}
+
+void UniformBuffer::SetData(const void* data, const uint32_t size, const uint32_t offset /* = 0 */) const
+{
+    if (offset > m_Size || size > m_Size - offset)
+    {
+        std::cout << "[ERROR] UniformBuffer: Writing " << size << " bytes at offset " << offset << " overflows the "
+            << m_Size << " bytes of buffer " << m_ID << '\n';
+        return;
+    }
+
+    RendererAPI& api = RendererAPI::Get();
+    api.BindBuffer(BufferTarget::Uniform, m_ID);
+    api.SetBufferSubData(BufferTarget::Uniform, offset, size, data);
+}
+
+int UniformBuffer::GetBlockBinding(const char* blockName)
+{
+    for (const BlockBinding& block : s_BlockBindings)
+    {
+        if (std::strcmp(block.Name, blockName) == 0)
+            return static_cast<int>(block.Binding);
+    }
+
+    return -1;
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstdint>
+
+// Fixed binding points shared by every program. Shader::Compile binds any uniform block whose
+// name matches one of them automatically, so shaders only have to declare the block.
+enum class UniformBinding : uint32_t
+{
+    Frame = 0 // "FrameData": camera, time and screen-shake, uploaded once per frame
+};
+
+class UniformBuffer
+{
+public:
+    UniformBuffer(uint32_t size, UniformBinding binding);
+    UniformBuffer(const UniformBuffer& other) = delete;
+    ~UniformBuffer();
+
+    // Writes past the end of the buffer are rejected (and logged) as a whole
+    void SetData(const void* data, uint32_t size, uint32_t offset = 0) const;
+
+    const unsigned int& GetID() const { return m_ID; }
+    UniformBinding GetBinding() const { return m_Binding; }
+
+    // Binding point of a uniform block, -1 if the block is not one of the shared ones
+    static int GetBlockBinding(const char* blockName);
+private:
+    unsigned int m_ID = 0;
+    uint32_t m_Size; // bytes
+    UniformBinding m_Binding;
+};
@@ -1,23 +1,53 @@
 ﻿#include "ResourceManager.h"
+#include "Debug/Profiler.h"
+#include "Renderer/RendererAPI.h"
 
+#include <algorithm>
+#include <chrono>
 #include <fstream>
 #include <iostream>
 #include <sstream>
 
-#include <glad/glad.h>
 #include <stb_image/stb_image.h>
 
+bool AsyncTexture::IsReady() const
+{
+    return m_State != nullptr && m_State->CurrentStatus.load(std::memory_order_acquire) == Status::Ready;
+}
+
+bool AsyncTexture::HasFailed() const
+{
+    return m_State != nullptr && m_State->CurrentStatus.load(std::memory_order_acquire) == Status::Failed;
+}
+
+std::shared_ptr<Texture2D> AsyncTexture::Get() const
+{
+    return IsReady() ? m_State->Texture : nullptr;
+}
+
 ResourceManager& ResourceManager::Instance()
 {
     static ResourceManager instance;
     return instance;
 }
 
+ResourceManager::~ResourceManager()
+{
+    DiscardPendingUploads();
+}
+
 std::shared_ptr<Shader> ResourceManager::LoadShader(const std::string& name, const char* vertexPath, const char* fragmentPath,
                                                     const char* geometryPath /* = nullptr */)
 {
-    m_Shaders[name] = LoadShaderFromFile(vertexPath, fragmentPath, geometryPath);
-    return m_Shaders[name].lock();
+    PROFILE_SCOPE("LoadShader");
+
+    // Packed sources take precedence, loose files remain the development path
+    auto shader = LoadShaderFromPack(vertexPath, fragmentPath, geometryPath);
+    if (shader == nullptr)
+        shader = LoadShaderFromFile(vertexPath, fragmentPath, geometryPath);
+
+    m_Shaders[name] = shader;
+    return shader;
 }
 
 std::shared_ptr<Shader> ResourceManager::GetShader(const std::string& name)
@@ -27,8 +57,14 @@ std::shared_ptr<Shader> ResourceManager::GetShader(const std::string& name)
 
 std::shared_ptr<Texture2D> ResourceManager::LoadTexture(const std::string& name, const char* filePath, bool useAlphaChannel)
 {
-    m_Textures[name] = LoadTexture2DFromFile(filePath, useAlphaChannel);
-    return m_Textures[name].lock();
+    PROFILE_SCOPE("LoadTexture");
+
+    auto texture = LoadTexture2DFromPack(filePath, useAlphaChannel);
+    if (texture == nullptr)
+        texture = LoadTexture2DFromFile(filePath, useAlphaChannel);
+
+    m_Textures[name] = texture;
+    return texture;
 }
 
 std::shared_ptr<Texture2D> ResourceManager::GetTexture(const std::string& name)
@@ -36,19 +72,171 @@ std::shared_ptr<Texture2D> ResourceManager::GetTexture(const std::string& name)
     return m_Textures[name].lock();
 }
 
-void ResourceManager::Clear() const
+bool ResourceManager::MountAssetPack(const char* filePath)
+{
+    if (!m_AssetPack.Open(filePath))
+        return false;
+
+    std::cout << "| [INFO] ResourceManager: Mounted '" << filePath << "' (" << m_AssetPack.GetEntryCount() << " entries)" << '\n';
+    return true;
+}
+
+std::shared_ptr<TextureAtlas> ResourceManager::LoadTextureAtlas(const std::string& name, const std::vector<std::pair<std::string, std::string>>& sprites,
+                                                                int pageSize /* = 2048 */)
+{
+    PROFILE_SCOPE("LoadTextureAtlas");
+
+    auto atlas = std::make_shared<TextureAtlas>(pageSize);
+
+    stbi_set_flip_vertically_on_load(1);
+    for (const auto& sprite : sprites)
+    {
+        if (const auto* entry = FindPackEntry(sprite.second.c_str(), AssetPackFormat::EntryType::Texture))
+        {
+            atlas->Add(sprite.first, m_AssetPack.GetData(*entry), entry->Width, entry->Height, entry->Channels);
+            continue;
+        }
+
+        int width, height, nrChannels;
+        unsigned char* data = stbi_load(sprite.second.c_str(), &width, &height, &nrChannels, 0);
+        if (data == nullptr)
+        {
+            std::cout << "[ERROR] TextureAtlas: Failed to load '" << sprite.second << "'. Error: " << stbi_failure_reason() << '\n';
+            continue;
+        }
+
+        atlas->Add(sprite.first, data, width, height, nrChannels);
+        stbi_image_free(data);
+    }
+
+    // Nothing is cached for a failed build, a later call may succeed with fixed images
+    if (!atlas->Build())
+        return nullptr;
+
+    m_TextureAtlases[name] = atlas;
+    return atlas;
+}
+
+std::shared_ptr<TextureAtlas> ResourceManager::GetTextureAtlas(const std::string& name)
+{
+    return m_TextureAtlases[name].lock();
+}
+
+AsyncTexture ResourceManager::LoadTextureAsync(const std::string& name, const char* filePath, bool useAlphaChannel)
+{
+    auto state = std::make_shared<AsyncTexture::State>();
+    state->Name = name;
+    state->FilePath = filePath;
+    state->UseAlphaChannel = useAlphaChannel;
+
+    // Packed textures are already decoded, they go straight to the upload queue
+    if (const auto* entry = FindPackEntry(filePath, AssetPackFormat::EntryType::Texture))
+    {
+        state->Pixels = const_cast<unsigned char*>(m_AssetPack.GetData(*entry));
+        state->OwnsPixels = false;
+        state->Width = entry->Width;
+        state->Height = entry->Height;
+        state->Channels = entry->Channels;
+        state->CurrentStatus.store(AsyncTexture::Status::Decoded, std::memory_order_release);
+
+        std::lock_guard<std::mutex> lock(m_UploadMutex);
+        m_UploadQueue.push_back(state);
+        return AsyncTexture(std::move(state));
+    }
+
+    JobSystem::RunBackground([this, state]() { DecodeTexture(state); }, &m_DecodeJobs);
+    return AsyncTexture(std::move(state));
+}
+
+void ResourceManager::ProcessUploads(const double budgetMilliseconds)
 {
+    PROFILE_SCOPE("ProcessUploads");
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::duration<double, std::milli>(budgetMilliseconds);
+
+    do
+    {
+        std::shared_ptr<AsyncTexture::State> state;
+        {
+            std::lock_guard<std::mutex> lock(m_UploadMutex);
+            if (m_UploadQueue.empty())
+                return;
+
+            state = std::move(m_UploadQueue.front());
+            m_UploadQueue.pop_front();
+        }
+
+        state->Texture = CreateTexture2D(state->FilePath.c_str(), state->Pixels, state->Width, state->Height, state->Channels, state->UseAlphaChannel);
+        if (state->OwnsPixels)
+            stbi_image_free(state->Pixels);
+        state->Pixels = nullptr;
+
+        if (state->Texture == nullptr)
+        {
+            state->CurrentStatus.store(AsyncTexture::Status::Failed, std::memory_order_release);
+            continue;
+        }
+
+        m_Textures[state->Name] = state->Texture;
+        state->CurrentStatus.store(AsyncTexture::Status::Ready, std::memory_order_release);
+    }
+    while (std::chrono::steady_clock::now() < deadline);
+}
+
+void ResourceManager::Clear()
+{
+    DiscardPendingUploads();
+
     // Delete shaders
     for (auto& it : m_Shaders)
     {
-        glDeleteProgram(it.second.lock()->GetID());
+        if (const auto shader = it.second.lock())
+            RendererAPI::Get().DeleteProgram(shader->GetID());
     }
 
     // Delete textures
     for (auto& it : m_Textures)
     {
-        glDeleteTextures(1, &it.second.lock()->GetID());
+        if (const auto texture = it.second.lock())
+            RendererAPI::Get().DeleteTexture(texture->GetID());
+    }
+}
+
+void ResourceManager::DecodeTexture(const std::shared_ptr<AsyncTexture::State>& state)
+{
+    // The flip flag is global in stb_image, decoding threads use their own
+    stbi_set_flip_vertically_on_load_thread(1);
+
+    {
+        PROFILE_SCOPE("DecodeTexture");
+        state->Pixels = stbi_load(state->FilePath.c_str(), &state->Width, &state->Height, &state->Channels, 0);
+    }
+    if (state->Pixels == nullptr)
+    {
+        std::cout << "[ERROR] Texture: Failed to load '" << state->FilePath << "'. Error: " << stbi_failure_reason() << '\n';
+        state->CurrentStatus.store(AsyncTexture::Status::Failed, std::memory_order_release);
+        return;
+    }
+
+    state->CurrentStatus.store(AsyncTexture::Status::Decoded, std::memory_order_release);
+
+    std::lock_guard<std::mutex> lock(m_UploadMutex);
+    m_UploadQueue.push_back(state);
+}
+
+void ResourceManager::DiscardPendingUploads()
+{
+    JobSystem::Wait(m_DecodeJobs);
+
+    // Decoded images that never made it to the GPU
+    std::lock_guard<std::mutex> lock(m_UploadMutex);
+    for (const auto& state : m_UploadQueue)
+    {
+        if (state->OwnsPixels)
+            stbi_image_free(state->Pixels);
+        state->Pixels = nullptr;
+        state->CurrentStatus.store(AsyncTexture::Status::Failed, std::memory_order_release);
     }
+    m_UploadQueue.clear();
 }
 
 std::shared_ptr<Shader> ResourceManager::LoadShaderFromFile(const char* vertexPath, const char* fragmentPath, const char* geometryPath /* = nullptr */)
@@ -96,6 +284,40 @@ std::shared_ptr<Shader> ResourceManager::LoadShaderFromFile(const char* vertexPa
     return shader;
 }
 
+const AssetPackFormat::PackEntry* ResourceManager::FindPackEntry(const char* filePath, const AssetPackFormat::EntryType type) const
+{
+    if (filePath == nullptr || !m_AssetPack.IsOpen())
+        return nullptr;
+
+    const auto* entry = m_AssetPack.Find(filePath);
+    return entry != nullptr && entry->Type == type ? entry : nullptr;
+}
+
+std::shared_ptr<Shader> ResourceManager::LoadShaderFromPack(const char* vertexPath, const char* fragmentPath, const char* geometryPath) const
+{
+    const auto* vertexEntry = FindPackEntry(vertexPath, AssetPackFormat::EntryType::Shader);
+    const auto* fragmentEntry = FindPackEntry(fragmentPath, AssetPackFormat::EntryType::Shader);
+    const auto* geometryEntry = FindPackEntry(geometryPath, AssetPackFormat::EntryType::Shader);
+    if (vertexEntry == nullptr || fragmentEntry == nullptr || (geometryPath != nullptr && geometryEntry == nullptr))
+        return nullptr;
+
+    // Packed sources are null-terminated, GL reads them straight from the mapping
+    const auto source = [this](const AssetPackFormat::PackEntry* entry)
+    {
+        return entry != nullptr ? reinterpret_cast<const char*>(m_AssetPack.GetData(*entry)) : nullptr;
+    };
+    return std::make_shared<Shader>(source(vertexEntry), source(fragmentEntry), source(geometryEntry));
+}
+
+std::shared_ptr<Texture2D> ResourceManager::LoadTexture2DFromPack(const char* filePath, bool useAlphaChannel) const
+{
+    const auto* entry = FindPackEntry(filePath, AssetPackFormat::EntryType::Texture);
+    if (entry == nullptr)
+        return nullptr;
+
+    return CreateTexture2D(filePath, m_AssetPack.GetData(*entry), entry->Width, entry->Height, entry->Channels, useAlphaChannel);
+}
+
 std::shared_ptr<Texture2D> ResourceManager::LoadTexture2DFromFile(const char* filePath, bool useAlphaChannel)
 {
     // Load image
@@ -103,17 +325,38 @@ std::shared_ptr<Texture2D> ResourceManager::LoadTexture2DFromFile(const char* fi
     stbi_set_flip_vertically_on_load(1);
 
     unsigned char* data = stbi_load(filePath, &width, &height, &nrChannels, 0);
+    if (data == nullptr)
+    {
+        std::cout << "[ERROR] Texture: Failed to load '" << filePath << "'. Error: " << stbi_failure_reason() << '\n';
+        return nullptr;
+    }
 
     // Create Texture2D object
-    auto texture = std::make_shared<Texture2D>(width, height, nrChannels);
-    texture->SetData(data, useAlphaChannel ? GL_RGBA : GL_RGB, useAlphaChannel ? GL_RGBA : GL_RGB, GL_UNSIGNED_BYTE);
-
-    // Set default wrap / filter modes
-    texture->SetFilterMode(GL_LINEAR);
-    texture->SetWrapMode(GL_REPEAT);
+    auto texture = CreateTexture2D(filePath, data, width, height, nrChannels, useAlphaChannel);
 
     // Finally, free image data
     stbi_image_free(data);
 
     return texture;
 }
+
+std::shared_ptr<Texture2D> ResourceManager::CreateTexture2D(const char* filePath, const unsigned char* data, int width, int height, int nrChannels, bool useAlphaChannel)
+{
+    // Fewer channels than the upload format would read past the end of the image
+    if (data == nullptr || width <= 0 || height <= 0 || nrChannels < (useAlphaChannel ? 4 : 3))
+    {
+        std::cout << "[ERROR] Texture: Cannot create '" << filePath << "' from a " << width << "x" << height << " image with "
+            << nrChannels << " channels" << (useAlphaChannel ? " as RGBA" : " as RGB") << '\n';
+        return nullptr;
+    }
+
+    auto texture = std::make_shared<Texture2D>(width, height, nrChannels);
+    texture->Bind();
+    texture->SetData(data, useAlphaChannel ? TextureFormat::RGBA : TextureFormat::RGB, PixelType::UnsignedByte);
+
+    // Set default wrap / filter modes
+    texture->SetFilterMode(TextureFilter::Linear);
+    texture->SetWrapMode(TextureWrap::Repeat);
+
+    return texture;
+}
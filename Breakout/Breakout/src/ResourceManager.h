@@ -1,32 +1,112 @@
 ﻿#pragma once
 
+#include "AssetPack.h"
+#include "Jobs/JobSystem.h"
 #include "Renderer/Shader.h"
 #include "Renderer/Texture2D.h"
+#include "Renderer/TextureAtlas.h"
 
+#include <atomic>
+#include <deque>
 #include <memory>
+#include <mutex>
 #include <unordered_map>
 #include <string>
+#include <vector>
+
+// Handle to a texture decoded in the background. The texture itself only exists once
+// ResourceManager::ProcessUploads has uploaded it on the render thread.
+class AsyncTexture
+{
+public:
+    AsyncTexture() = default;
+
+    bool IsReady() const;
+    bool HasFailed() const;
+    // nullptr until the texture is ready
+    std::shared_ptr<Texture2D> Get() const;
+private:
+    enum class Status : uint8_t
+    {
+        Decoding,
+        Decoded,
+        Ready,
+        Failed
+    };
+
+    struct State
+    {
+        std::string Name;
+        std::string FilePath;
+        bool UseAlphaChannel = false;
+
+        unsigned char* Pixels = nullptr;
+        bool OwnsPixels = true; // false when pointing into the mounted asset pack
+        int Width = 0, Height = 0, Channels = 0;
+
+        std::atomic<Status> CurrentStatus{ Status::Decoding };
+        std::shared_ptr<Texture2D> Texture;
+    };
+
+    explicit AsyncTexture(std::shared_ptr<State> state) : m_State(std::move(state)) {}
+
+    friend class ResourceManager;
+private:
+    std::shared_ptr<State> m_State;
+};
 
 class ResourceManager
 {
 public:
     static ResourceManager& Instance();
 
+    // Once a pack is mounted, shaders and textures are looked up in it by file path first (falling back to loose files)
+    bool MountAssetPack(const char* filePath);
+
     std::shared_ptr<Shader> LoadShader(const std::string& name, const char* vertexPath, const char* fragmentPath, const char* geometryPath = nullptr);
     std::shared_ptr<Shader> GetShader(const std::string& name);
 
+    // nullptr when the image cannot be loaded
     std::shared_ptr<Texture2D> LoadTexture(const std::string& name, const char* filePath, bool useAlphaChannel);
     std::shared_ptr<Texture2D> GetTexture(const std::string& name);
 
-    void Clear() const;
+    // Decodes the image as a background job, never on the calling thread; the GL upload happens later in ProcessUploads
+    AsyncTexture LoadTextureAsync(const std::string& name, const char* filePath, bool useAlphaChannel);
+    // Uploads decoded textures on the calling (GL) thread until the time budget is spent, at least one per call.
+    // Images that cannot back a texture (see CreateTexture2D) fail.
+    void ProcessUploads(double budgetMilliseconds);
+
+    // Packs every (sprite name, file path) pair into a single atlas, nullptr (and nothing cached) when it cannot be built
+    std::shared_ptr<TextureAtlas> LoadTextureAtlas(const std::string& name, const std::vector<std::pair<std::string, std::string>>& sprites, int pageSize = 2048);
+    std::shared_ptr<TextureAtlas> GetTextureAtlas(const std::string& name);
+
+    void Clear();
 private:
     ResourceManager() = default;
+    ~ResourceManager();
     static std::shared_ptr<Shader> LoadShaderFromFile(const char* vertexPath, const char* fragmentPath, const char* geometryPath = nullptr);
     static std::shared_ptr<Texture2D> LoadTexture2DFromFile(const char* filePath, bool useAlphaChannel);
+    const AssetPackFormat::PackEntry* FindPackEntry(const char* filePath, AssetPackFormat::EntryType type) const;
+    std::shared_ptr<Shader> LoadShaderFromPack(const char* vertexPath, const char* fragmentPath, const char* geometryPath) const;
+    std::shared_ptr<Texture2D> LoadTexture2DFromPack(const char* filePath, bool useAlphaChannel) const;
+    // nullptr, after logging why, when the image cannot back an RGB (RGBA with useAlphaChannel) texture
+    static std::shared_ptr<Texture2D> CreateTexture2D(const char* filePath, const unsigned char* data, int width, int height, int nrChannels, bool useAlphaChannel);
+
+    void DecodeTexture(const std::shared_ptr<AsyncTexture::State>& state);
+    // Waits for the decode jobs in flight and frees the images that were never uploaded, their textures fail
+    void DiscardPendingUploads();
 
     friend class Shader;
     friend class Texture2D;
 private:
     std::unordered_map<std::string, std::weak_ptr<Shader>> m_Shaders;
     std::unordered_map<std::string, std::weak_ptr<Texture2D>> m_Textures;
+    std::unordered_map<std::string, std::weak_ptr<TextureAtlas>> m_TextureAtlases;
+
+    AssetPack m_AssetPack;
+
+    // Background decoding
+    JobCounter m_DecodeJobs;
+    std::deque<std::shared_ptr<AsyncTexture::State>> m_UploadQueue;
+    std::mutex m_UploadMutex;
 };
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+// Shared by the Tests and Bench runners: cases register themselves before main (see HARNESS_CASE), main hands each
+// one whose name contains its first argument, or every case without one, to the runner's own reporting.
+namespace Harness
+{
+    using Function = void(*)();
+
+    struct Case
+    {
+        const char* Name;
+        Function Run;
+    };
+
+    inline std::vector<Case>& GetCases()
+    {
+        static std::vector<Case> cases;
+        return cases;
+    }
+
+    struct Registrar
+    {
+        Registrar(const char* name, const Function function) { GetCases().push_back({ name, function }); }
+    };
+
+    // Calls runCase(const Case&) for the selected cases, in registration order
+    template<typename RunCase>
+    void RunCases(const int argc, char** argv, RunCase&& runCase)
+    {
+        const char* filter = argc > 1 ? argv[1] : nullptr;
+        for (const Case& registered : GetCases())
+        {
+            if (filter == nullptr || std::strstr(registered.Name, filter) != nullptr)
+                runCase(registered);
+        }
+    }
+
+    // Linear congruential generator: the same sequence on every platform and compiler, so that test and benchmark
+    // inputs are reproducible. The low bits of the state are poor, only the top 24 are handed out.
+    class Random
+    {
+    public:
+        explicit Random(const uint32_t seed) : m_State(seed) {}
+
+        // [0, 2^24)
+        uint32_t Next()
+        {
+            m_State = m_State * 1664525u + 1013904223u;
+            return m_State >> 8;
+        }
+
+        // [min, max], in 65536 steps
+        float NextFloat(const float min, const float max)
+        {
+            return min + (max - min) * static_cast<float>(Next() % 65536) / 65535.0f;
+        }
+    private:
+        uint32_t m_State;
+    };
+}
+
+#define HARNESS_CASE(name)                                          \
+    static void name();                                             \
+    static const Harness::Registrar name##Registrar(#name, name);   \
+    static void name()
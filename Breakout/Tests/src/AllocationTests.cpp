@@ -0,0 +1,104 @@
+// Steady-state frames must not touch the heap. Only meaningful when the project is built with
+// BREAKOUT_COUNT_ALLOCATIONS=1, which replaces the global operator new/delete by counting versions.
+
+#include "Test.h"
+
+#include <Debug/AllocationCounter.h>
+#include <Game.h>
+#include <Level/BrickGrid.h>
+#include <Memory/FrameArena.h>
+#include <Physics/Collision.h>
+
+#include <cstdint>
+#include <vector>
+
+namespace
+{
+    constexpr uint64_t WarmupTicks = 60;
+    constexpr uint64_t MeasuredTicks = 600;
+}
+
+TEST(AllocationsAreCounted)
+{
+    CHECK(AllocationCounter::Enabled);
+
+    // Direct calls, new expressions may be optimized out
+    const uint64_t before = AllocationCounter::GetCount();
+    ::operator delete(::operator new(16));
+    CHECK(AllocationCounter::GetCount() == before + 1);
+}
+
+// Ticks and frames of the scripted level built on the null backend, after the pools and arenas have grown during the
+// warm-up ticks. The measured ticks must do real work: balls colliding, bricks and balls batched, debris uploaded.
+TEST(HeadlessFramesDoNotAllocate)
+{
+    Game game(800, 600, "Tests", RunMode::Headless);
+    const Game::HeadlessResult result = game.RunHeadless(WarmupTicks + MeasuredTicks, true, WarmupTicks);
+
+    CHECK(result.Ticks == WarmupTicks + MeasuredTicks);
+    CHECK(result.Impacts > 0);
+    CHECK(result.Quads >= MeasuredTicks * 3);
+    CHECK(result.DrawCalls >= MeasuredTicks);
+    CHECK(result.ParticleBytes > 0);
+    CHECK(result.Allocations == 0);
+    CHECK(result.MaxTickAllocations == 0);
+}
+
+TEST(FrameContainersDoNotAllocate)
+{
+    FrameArena::Initialize(64 * 1024);
+
+    uint64_t allocations = 0;
+    for (uint64_t frame = 0; frame < WarmupTicks + MeasuredTicks; frame++)
+    {
+        const uint64_t before = AllocationCounter::GetCount();
+        FrameArena::BeginFrame();
+
+        FrameVector<uint32_t> values;
+        for (uint32_t i = 0; i < 1000; i++)
+            values.push_back(i);
+        FrameString text("frame arena strings are longer than the small string buffer");
+        text += text;
+
+        if (frame >= WarmupTicks)
+            allocations += AllocationCounter::GetCount() - before;
+    }
+    CHECK(allocations == 0);
+
+    FrameArena::Shutdown();
+}
+
+// The broad phase results go to a scratch vector owned by the caller: with both vectors at their largest possible
+// size up front, nothing is left to allocate
+TEST(MoveBallDoesNotAllocate)
+{
+    BrickGrid grid(40, 30, { 0.0f, 0.0f }, { 20.0f, 10.0f });
+    for (uint32_t row = 0; row < 30; row++)
+    {
+        for (uint32_t column = 0; column < 40; column++)
+            grid.SetBrick(column, row, 255, 1.0f);
+    }
+    const std::vector<Collision::Box> walls = {
+        { { -10.0f, -10.0f }, { 0.0f, 600.0f } },
+        { { 800.0f, -10.0f }, { 810.0f, 600.0f } },
+        { { 0.0f, -10.0f }, { 800.0f, 0.0f } },
+        { { 0.0f, 590.0f }, { 800.0f, 600.0f } }
+    };
+
+    Collision::Ball ball{ { 400.0f, 500.0f }, { 2317.0f, -1911.0f }, 4.0f };
+    std::vector<Collision::Impact> impacts;
+    impacts.reserve(Collision::MaxImpactsPerMove);
+    std::vector<uint32_t> scratch;
+    scratch.reserve(grid.GetStride() * grid.GetRows());
+
+    const uint64_t before = AllocationCounter::GetCount();
+    uint64_t impactCount = 0;
+    for (uint64_t tick = 0; tick < MeasuredTicks; tick++)
+    {
+        impacts.clear();
+        Collision::MoveBall(ball, 1.0f / 60.0f, grid, walls, impacts, scratch);
+        impactCount += impacts.size();
+    }
+    CHECK(impactCount > 0);
+    CHECK(AllocationCounter::GetCount() == before);
+}
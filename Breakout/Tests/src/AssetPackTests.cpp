@@ -0,0 +1,95 @@
+// Corrupted or hostile asset packs must be rejected by Open, before any entry reaches a loader
+
+#include "Test.h"
+
+#include <AssetPack.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+using namespace AssetPackFormat;
+
+namespace
+{
+    // Past the header, the table of contents and the name
+    constexpr uint64_t BlobOffset = 2 * BlobAlignment;
+
+    // Single entry pack: header, table of contents, name, then the blob
+    std::string WritePack(const PackEntry& entry, const std::vector<unsigned char>& blob, const uint32_t entryCount = 1)
+    {
+        const char name[] = "asset";
+        constexpr uint64_t tocOffset = sizeof(PackHeader);
+        constexpr uint64_t namesOffset = tocOffset + sizeof(PackEntry);
+
+        const PackHeader header{ Magic, Version, entryCount, 0, tocOffset, namesOffset };
+        PackEntry written = entry;
+        written.NameOffset = 0;
+        written.NameLength = sizeof(name) - 1;
+
+        std::vector<unsigned char> bytes(BlobOffset + blob.size());
+        std::memcpy(bytes.data(), &header, sizeof(header));
+        std::memcpy(bytes.data() + tocOffset, &written, sizeof(written));
+        std::memcpy(bytes.data() + namesOffset, name, sizeof(name) - 1);
+        if (!blob.empty())
+            std::memcpy(bytes.data() + BlobOffset, blob.data(), blob.size());
+
+        const std::string path = (std::filesystem::temp_directory_path() / "breakout_tests.pak").string();
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+        return path;
+    }
+
+    bool Opens(const PackEntry& entry, const std::vector<unsigned char>& blob, const uint32_t entryCount = 1)
+    {
+        const std::string path = WritePack(entry, blob, entryCount);
+        AssetPack pack;
+        const bool opened = pack.Open(path.c_str());
+        pack.Close();
+        std::remove(path.c_str());
+        return opened;
+    }
+
+    PackEntry Texture(const int32_t width, const int32_t height, const int32_t channels, const uint64_t size)
+    {
+        return { BlobOffset, size, 0, 0, EntryType::Texture, width, height, channels };
+    }
+}
+
+TEST(AssetPackAcceptsValidEntries)
+{
+    CHECK(Opens(Texture(4, 4, 4, 64), std::vector<unsigned char>(64)));
+
+    const char source[] = "void main() {}";
+    const std::vector<unsigned char> shader(source, source + sizeof(source));
+    CHECK(Opens({ BlobOffset, shader.size(), 0, 0, EntryType::Shader, 0, 0, 0 }, shader));
+}
+
+TEST(AssetPackRejectsShortTextures)
+{
+    CHECK(!Opens(Texture(4, 4, 4, 63), std::vector<unsigned char>(64)));
+    CHECK(!Opens(Texture(0, 4, 4, 64), std::vector<unsigned char>(64)));
+    CHECK(!Opens(Texture(4, 4, 5, 64), std::vector<unsigned char>(64)));
+    // width * height * channels wraps around to a small number in 64 bits
+    CHECK(!Opens(Texture(INT32_MAX, INT32_MAX, 4, 64), std::vector<unsigned char>(64)));
+}
+
+TEST(AssetPackRejectsUnterminatedShaders)
+{
+    const std::vector<unsigned char> shader = { 'v', 'o', 'i', 'd' };
+    CHECK(!Opens({ BlobOffset, shader.size(), 0, 0, EntryType::Shader, 0, 0, 0 }, shader));
+    CHECK(!Opens({ BlobOffset, 0, 0, 0, EntryType::Shader, 0, 0, 0 }, {}));
+}
+
+TEST(AssetPackRejectsOverflowingOffsets)
+{
+    // DataOffset + DataSize wraps around to a small number
+    CHECK(!Opens({ BlobOffset, UINT64_MAX - BlobOffset + 2, 0, 0, EntryType::Raw, 0, 0, 0 }, std::vector<unsigned char>(16)));
+    CHECK(!Opens({ UINT64_MAX, 2, 0, 0, EntryType::Raw, 0, 0, 0 }, std::vector<unsigned char>(16)));
+    // A table of contents running past the end of the file
+    CHECK(!Opens({ BlobOffset, 16, 0, 0, EntryType::Raw, 0, 0, 0 }, std::vector<unsigned char>(16), UINT32_MAX));
+}
@@ -0,0 +1,85 @@
+// Every texture loaded in the background must end up ready or failed, never stuck on its way to the GPU
+
+#include "Test.h"
+
+#include <Jobs/JobSystem.h>
+#include <Renderer/RendererAPI.h>
+#include <ResourceManager.h>
+
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+
+namespace
+{
+    constexpr auto UploadTimeout = std::chrono::seconds(5);
+
+    // 2x2 binary PPM, three channels
+    std::string WriteImage()
+    {
+        const char image[] = "P6\n2 2\n255\n\xFF\x00\x00\x00\xFF\x00\x00\x00\xFF\xFF\xFF\xFF";
+        const std::string path = (std::filesystem::temp_directory_path() / "breakout_tests.ppm").string();
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file.write(image, sizeof(image) - 1);
+        return path;
+    }
+
+    // Uploads until the texture leaves the queue, one at a time as the decode finishes in the background
+    void UploadUntilDone(const AsyncTexture& texture)
+    {
+        const auto deadline = std::chrono::steady_clock::now() + UploadTimeout;
+        while (!texture.IsReady() && !texture.HasFailed() && std::chrono::steady_clock::now() < deadline)
+        {
+            ResourceManager::Instance().ProcessUploads(0.0);
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+}
+
+TEST(AsyncTextureBecomesReady)
+{
+    RendererAPI::Create(RendererAPI::API::Null);
+    JobSystem::Initialize();
+    const std::string path = WriteImage();
+
+    const AsyncTexture texture = ResourceManager::Instance().LoadTextureAsync("Image", path.c_str(), false);
+    UploadUntilDone(texture);
+    CHECK(texture.IsReady());
+    CHECK(texture.Get() != nullptr);
+
+    JobSystem::Shutdown();
+    std::remove(path.c_str());
+}
+
+TEST(AsyncTextureWithTooFewChannelsFails)
+{
+    RendererAPI::Create(RendererAPI::API::Null);
+    JobSystem::Initialize();
+    const std::string path = WriteImage();
+
+    // RGBA from an RGB image would read past the pixels
+    const AsyncTexture texture = ResourceManager::Instance().LoadTextureAsync("Image", path.c_str(), true);
+    UploadUntilDone(texture);
+    CHECK(texture.HasFailed());
+    CHECK(texture.Get() == nullptr);
+
+    JobSystem::Shutdown();
+    std::remove(path.c_str());
+}
+
+TEST(DiscardedAsyncTextureFails)
+{
+    RendererAPI::Create(RendererAPI::API::Null);
+    JobSystem::Initialize();
+    const std::string path = WriteImage();
+
+    const AsyncTexture texture = ResourceManager::Instance().LoadTextureAsync("Image", path.c_str(), false);
+    ResourceManager::Instance().Clear();
+    CHECK(texture.HasFailed());
+
+    JobSystem::Shutdown();
+    std::remove(path.c_str());
+}
@@ -0,0 +1,226 @@
+// Collision::MoveBall and SweepCircleBox on hand-built scenes whose times of impact and normals are known exactly.
+// Every case runs on a fixed input, results must not vary from one run or machine to the next.
+
+#include "Test.h"
+
+#include <Level/BrickGrid.h>
+#include <Physics/Collision.h>
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+namespace
+{
+    // Times are seconds, positions are in pixels
+    constexpr float TimeTolerance = 1e-6f;
+    constexpr float PositionTolerance = 1e-3f;
+    constexpr float NormalTolerance = 1e-5f;
+
+    void CheckImpact(const Collision::Impact& impact, const Collision::Target type, const uint32_t index, const float time,
+        const glm::vec2& normal)
+    {
+        CHECK(impact.Type == type);
+        CHECK(impact.Index == index);
+        CHECK_NEAR(impact.Time, time, TimeTolerance);
+        CHECK_NEAR(impact.Normal.x, normal.x, NormalTolerance);
+        CHECK_NEAR(impact.Normal.y, normal.y, NormalTolerance);
+    }
+}
+
+// A ball crossing 16000 px in one tick against a wall of bricks 1 px thick must stop on the wall, not behind it
+TEST(HighSpeedBallDoesNotTunnelThroughThinWall)
+{
+    BrickGrid grid(10, 10, { 0.0f, 100.0f }, { 80.0f, 1.0f });
+    for (uint32_t column = 0; column < 10; column++)
+        grid.SetBrick(column, 5, 1); // y in [105, 106]
+
+    Collision::Ball ball{ { 440.0f, 500.0f }, { 0.0f, -1000000.0f }, 5.0f };
+    std::vector<Collision::Impact> impacts;
+    std::vector<uint32_t> scratch;
+    Collision::MoveBall(ball, 1.0f / 60.0f, grid, {}, impacts, scratch);
+
+    // Top of the ball reaches the bottom of brick 5 after 389 px
+    CHECK(impacts.size() == 1);
+    if (impacts.size() != 1)
+        return;
+
+    CheckImpact(impacts[0], Collision::Target::Brick, grid.GetIndex(5, 5), 389.0f / 1000000.0f, { 0.0f, 1.0f });
+    CHECK(impacts[0].Destroyed);
+    CHECK_NEAR(impacts[0].Position.x, 440.0f, PositionTolerance);
+    CHECK_NEAR(impacts[0].Position.y, 111.0f, PositionTolerance);
+    CHECK(!grid.IsAlive(grid.GetIndex(5, 5)));
+    CHECK(grid.GetAliveCount() == 9);
+
+    // Reflected, and carried back down for the rest of the tick
+    CHECK(ball.Velocity == glm::vec2(0.0f, 1000000.0f));
+    CHECK(ball.Position.y > 500.0f);
+}
+
+// Moving diagonally straight at a corner: contact on the rounded corner, normal along the diagonal
+TEST(ExactCornerHit)
+{
+    BrickGrid grid(10, 10, { 0.0f, 100.0f }, { 80.0f, 20.0f });
+    grid.SetBrick(5, 5, 3); // [400, 480] x [200, 220]
+
+    Collision::Ball ball{ { 370.0f, 250.0f }, { 100.0f, -100.0f }, 5.0f };
+    std::vector<Collision::Impact> impacts;
+    std::vector<uint32_t> scratch;
+    Collision::MoveBall(ball, 1.0f, grid, {}, impacts, scratch);
+
+    // The center stops one radius from the corner (400, 220) along the diagonal
+    const float diagonal = 5.0f / std::sqrt(2.0f);
+    CHECK(impacts.size() == 1);
+    if (impacts.size() != 1)
+        return;
+
+    CheckImpact(impacts[0], Collision::Target::Brick, grid.GetIndex(5, 5), (30.0f - diagonal) / 100.0f,
+        glm::vec2(-1.0f, 1.0f) / std::sqrt(2.0f));
+    CHECK(!impacts[0].Destroyed);
+    CHECK_NEAR(impacts[0].Position.x, 400.0f - diagonal, PositionTolerance);
+    CHECK_NEAR(impacts[0].Position.y, 220.0f + diagonal, PositionTolerance);
+    CHECK(grid.GetHitPoints(grid.GetIndex(5, 5)) == 2);
+
+    CHECK_NEAR(ball.Velocity.x, -100.0f, 1e-3f);
+    CHECK_NEAR(ball.Velocity.y, 100.0f, 1e-3f);
+}
+
+// A face and a corner reached at the same time: the face wins, even against a brick which would otherwise win ties
+TEST(SimultaneousFaceAndCornerPrefersFace)
+{
+    // Brick (4, 5) covers [317, 397] x [201, 221], its bottom right corner is 3-4-5 away from where the box is hit
+    BrickGrid grid(10, 10, { -3.0f, 101.0f }, { 80.0f, 20.0f });
+    grid.SetBrick(4, 5, 1);
+    const std::vector<Collision::Box> boxes = { { { 398.0f, 200.0f }, { 480.0f, 220.0f } } };
+
+    Collision::Ball ball{ { 400.0f, 250.0f }, { 0.0f, -300.0f }, 5.0f };
+    std::vector<Collision::Impact> impacts;
+    std::vector<uint32_t> scratch;
+    Collision::MoveBall(ball, 1.0f, grid, boxes, impacts, scratch);
+
+    CHECK(impacts.size() == 1);
+    if (impacts.size() != 1)
+        return;
+
+    CheckImpact(impacts[0], Collision::Target::Box, 0, 25.0f / 300.0f, { 0.0f, 1.0f });
+    CHECK(grid.IsAlive(grid.GetIndex(4, 5)));
+    CHECK(ball.Velocity == glm::vec2(0.0f, 300.0f));
+}
+
+// Two faces at the seam between adjacent bricks: a single bounce off the lowest brick, not a corner deflection
+TEST(SimultaneousFacesPreferLowestBrick)
+{
+    BrickGrid grid(10, 10, { 0.0f, 100.0f }, { 80.0f, 20.0f });
+    grid.SetBrick(4, 5, 1);
+    grid.SetBrick(5, 5, 1);
+
+    Collision::Ball ball{ { 400.0f, 250.0f }, { 0.0f, -300.0f }, 5.0f };
+    std::vector<Collision::Impact> impacts;
+    std::vector<uint32_t> scratch;
+    Collision::MoveBall(ball, 1.0f, grid, {}, impacts, scratch);
+
+    CHECK(impacts.size() == 1);
+    if (impacts.size() != 1)
+        return;
+
+    CheckImpact(impacts[0], Collision::Target::Brick, grid.GetIndex(4, 5), 25.0f / 300.0f, { 0.0f, 1.0f });
+    CHECK(grid.IsAlive(grid.GetIndex(5, 5)));
+    CHECK(ball.Velocity == glm::vec2(0.0f, 300.0f));
+}
+
+// A ball left touching (or slightly inside) a face by its last bounce is free to leave, but hits at once going in
+TEST(RestingContactMovingAway)
+{
+    const Collision::Box box{ { 400.0f, 200.0f }, { 480.0f, 220.0f } };
+    Collision::SweepHit hit{};
+
+    CHECK(!Collision::SweepCircleBox({ 440.0f, 225.0f }, 5.0f, { 0.0f, 5.0f }, box, hit));
+    CHECK(!Collision::SweepCircleBox({ 440.0f, 224.99f }, 5.0f, { 0.0f, 5.0f }, box, hit));
+    // Sliding along the face is not a hit either
+    CHECK(!Collision::SweepCircleBox({ 440.0f, 225.0f }, 5.0f, { 5.0f, 0.0f }, box, hit));
+
+    CHECK(Collision::SweepCircleBox({ 440.0f, 225.0f }, 5.0f, { 0.0f, -5.0f }, box, hit));
+    CHECK(hit.Time == 0.0f);
+    CHECK(hit.Normal == glm::vec2(0.0f, 1.0f));
+
+    BrickGrid grid(10, 10, { 0.0f, 100.0f }, { 80.0f, 20.0f });
+    grid.SetBrick(5, 5, 1);
+    Collision::Ball ball{ { 440.0f, 225.0f }, { 0.0f, 300.0f }, 5.0f };
+    std::vector<Collision::Impact> impacts;
+    std::vector<uint32_t> scratch;
+    Collision::MoveBall(ball, 0.1f, grid, {}, impacts, scratch);
+
+    CHECK(impacts.empty());
+    CHECK(grid.IsAlive(grid.GetIndex(5, 5)));
+    CHECK_NEAR(ball.Position.y, 255.0f, PositionTolerance);
+}
+
+// Wedged in a channel barely wider than itself, a fast ball would bounce forever: the move stops after
+// MaxImpactsPerMove impacts, alternating walls in time order
+TEST(WedgedBallTerminates)
+{
+    BrickGrid grid(1, 1, { 0.0f, 0.0f }, { 1.0f, 1.0f });
+    const std::vector<Collision::Box> boxes = {
+        { { -10.0f, 0.0f }, { 0.0f, 100.0f } },
+        { { 11.0f, 0.0f }, { 21.0f, 100.0f } }
+    };
+
+    // 0.5 px to the right wall, then 1 px between the walls
+    Collision::Ball ball{ { 5.5f, 50.0f }, { 10000.0f, 0.0f }, 5.0f };
+    std::vector<Collision::Impact> impacts;
+    std::vector<uint32_t> scratch;
+    Collision::MoveBall(ball, 1.0f, grid, boxes, impacts, scratch);
+
+    CHECK(impacts.size() == Collision::MaxImpactsPerMove);
+    for (uint32_t i = 0; i < impacts.size(); i++)
+    {
+        const bool rightWall = i % 2 == 0;
+        CheckImpact(impacts[i], Collision::Target::Box, rightWall ? 1 : 0, 0.00005f + i * 0.0001f,
+            { rightWall ? -1.0f : 1.0f, 0.0f });
+        if (i > 0)
+            CHECK(impacts[i].Time > impacts[i - 1].Time);
+    }
+
+    CHECK(ball.Position.x >= 5.0f - PositionTolerance && ball.Position.x <= 6.0f + PositionTolerance);
+}
+
+// Same ball through the same randomly filled field twice: identical impacts, bit for bit
+TEST(RepeatedRunsAreIdentical)
+{
+    const std::vector<Collision::Box> walls = {
+        { { -10.0f, -10.0f }, { 0.0f, 600.0f } },
+        { { 800.0f, -10.0f }, { 810.0f, 600.0f } },
+        { { 0.0f, -10.0f }, { 800.0f, 0.0f } },
+        { { 0.0f, 590.0f }, { 800.0f, 600.0f } }
+    };
+
+    std::vector<Collision::Impact> runs[2];
+    for (std::vector<Collision::Impact>& run : runs)
+    {
+        BrickGrid grid(40, 30, { 0.0f, 0.0f }, { 20.0f, 10.0f });
+        Harness::Random random(7);
+        for (uint32_t row = 0; row < 30; row++)
+        {
+            for (uint32_t column = 0; column < 40; column++)
+                grid.SetBrick(column, row, static_cast<uint8_t>((random.Next() >> 8) % 3), 1.0f);
+        }
+
+        Collision::Ball ball{ { 400.0f, 500.0f }, { 2317.0f, -1911.0f }, 4.0f };
+        std::vector<uint32_t> scratch;
+        for (int tick = 0; tick < 600; tick++)
+        {
+            Collision::MoveBall(ball, 1.0f / 60.0f, grid, walls, run, scratch);
+            CHECK(ball.Position.x >= 0.0f && ball.Position.x <= 800.0f && ball.Position.y >= 0.0f && ball.Position.y <= 590.0f);
+        }
+    }
+
+    CHECK(!runs[0].empty());
+    CHECK(runs[0].size() == runs[1].size());
+    for (size_t i = 0; i < runs[0].size() && i < runs[1].size(); i++)
+    {
+        const Collision::Impact& first = runs[0][i];
+        const Collision::Impact& second = runs[1][i];
+        CHECK(first.Type == second.Type && first.Index == second.Index && first.Destroyed == second.Destroyed);
+        CHECK(first.Time == second.Time && first.Position == second.Position && first.Normal == second.Normal);
+    }
+}
@@ -0,0 +1,105 @@
+// GPU pass timing on the null backend, which records the timer queries and reports every result as ready
+
+#include "Test.h"
+
+#include <Renderer/NullRendererAPI.h>
+#include <Renderer/Renderer.h>
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace
+{
+    // Timer query commands recorded since the last reset
+    std::vector<NullRendererAPI::Command> TimerCommands(NullRendererAPI& recorder)
+    {
+        std::vector<NullRendererAPI::Command> commands;
+        for (const NullRendererAPI::Command& command : recorder.GetCommands())
+        {
+            if (command.Type == NullRendererAPI::CommandType::BeginTimerQuery ||
+                command.Type == NullRendererAPI::CommandType::EndTimerQuery)
+                commands.push_back(command);
+        }
+        recorder.Reset();
+        return commands;
+    }
+
+    bool HasTiming(const char* name)
+    {
+        for (const Renderer::GpuPassTiming& timing : Renderer::GetGpuTimings())
+        {
+            if (std::strcmp(timing.Name, name) == 0)
+                return true;
+        }
+        return false;
+    }
+}
+
+TEST(NestedPassSuspendsTheEnclosingQuery)
+{
+    Renderer::Initialize(RendererAPI::API::Null);
+    auto& recorder = static_cast<NullRendererAPI&>(RendererAPI::Get());
+    Renderer::BeginFrame(Renderer::FrameData());
+    recorder.Reset();
+
+    Renderer::BeginPass("Outer");
+    Renderer::BeginPass("Inner");
+    Renderer::EndPass();
+    Renderer::EndPass();
+
+    // Outer, Inner, then Outer again in a query of its own: never two queries open at once
+    const std::vector<NullRendererAPI::Command> commands = TimerCommands(recorder);
+    CHECK(commands.size() == 6);
+    if (commands.size() == 6)
+    {
+        for (size_t i = 0; i < commands.size(); i++)
+        {
+            const NullRendererAPI::CommandType expected = i % 2 == 0
+                ? NullRendererAPI::CommandType::BeginTimerQuery : NullRendererAPI::CommandType::EndTimerQuery;
+            CHECK(commands[i].Type == expected);
+        }
+        CHECK(commands[0].Object != commands[2].Object);
+        CHECK(commands[2].Object != commands[4].Object);
+        CHECK(commands[0].Object != commands[4].Object);
+    }
+    CHECK(Renderer::GetStats().DroppedGpuPasses == 0);
+
+    Renderer::BeginFrame(Renderer::FrameData());
+    CHECK(HasTiming("Outer"));
+    CHECK(HasTiming("Inner"));
+
+    Renderer::Shutdown();
+}
+
+TEST(PassesOverTheBudgetAreCounted)
+{
+    Renderer::Initialize(RendererAPI::API::Null);
+    auto& recorder = static_cast<NullRendererAPI&>(RendererAPI::Get());
+    Renderer::BeginFrame(Renderer::FrameData());
+    Renderer::ResetStats();
+    recorder.Reset();
+
+    for (int pass = 0; pass < 10; pass++)
+    {
+        Renderer::BeginPass("Pass");
+        Renderer::EndPass();
+    }
+    // Nested in a dropped pass: dropped as well, and its EndPass must not end anything
+    Renderer::BeginPass("Dropped");
+    Renderer::BeginPass("Nested");
+    Renderer::EndPass();
+    Renderer::EndPass();
+
+    CHECK(Renderer::GetStats().DroppedGpuPasses == 4);
+    CHECK(TimerCommands(recorder).size() == 16);
+
+    // The budget is per frame
+    Renderer::BeginFrame(Renderer::FrameData());
+    Renderer::BeginPass("Pass");
+    Renderer::EndPass();
+    CHECK(TimerCommands(recorder).size() == 2);
+    CHECK(Renderer::GetStats().DroppedGpuPasses == 4);
+
+    Renderer::Shutdown();
+}
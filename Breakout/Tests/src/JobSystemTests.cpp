@@ -0,0 +1,59 @@
+// Background jobs (texture decodes) must stay off the threads that wait on frame work
+
+#include "Test.h"
+
+#include <Jobs/JobSystem.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+namespace
+{
+    constexpr uint32_t BackgroundJobCount = 8;
+}
+
+TEST(BackgroundJobsNeverRunOnTheWaitingThread)
+{
+    JobSystem::Initialize();
+    const std::thread::id mainThread = std::this_thread::get_id();
+
+    std::atomic<uint32_t> ranOnMainThread{ 0 };
+    JobCounter background;
+    for (uint32_t i = 0; i < BackgroundJobCount; i++)
+    {
+        JobSystem::RunBackground([&ranOnMainThread, mainThread]()
+        {
+            if (std::this_thread::get_id() == mainThread)
+                ranOnMainThread++;
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }, &background);
+    }
+
+    // What a frame does while the decodes are queued
+    std::atomic<uint32_t> processed{ 0 };
+    JobSystem::ParallelFor(64, 4, [&processed](const uint32_t begin, const uint32_t end) { processed += end - begin; });
+    JobCounter frame;
+    for (uint32_t i = 0; i < 16; i++)
+        JobSystem::Run([&processed]() { processed++; }, &frame);
+    JobSystem::Wait(frame);
+    JobSystem::Wait(background);
+
+    CHECK(processed == 80);
+    CHECK(background.IsDone());
+    CHECK(ranOnMainThread == 0);
+    JobSystem::Shutdown();
+}
+
+// Without pool threads nobody else would run them
+TEST(WaitRunsBackgroundJobsWithoutThreads)
+{
+    JobSystem::Shutdown();
+
+    bool ran = false;
+    JobCounter counter;
+    JobSystem::RunBackground([&ran]() { ran = true; }, &counter);
+    JobSystem::Wait(counter);
+
+    CHECK(ran);
+}
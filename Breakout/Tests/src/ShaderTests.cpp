@@ -0,0 +1,82 @@
+// Uniform lookups and the value shadow on the null backend, which records the location of every upload
+
+#include "Test.h"
+
+#include <Renderer/NullRendererAPI.h>
+#include <Renderer/Shader.h>
+
+#include <cstdint>
+#include <vector>
+
+namespace
+{
+    const char* const s_VertexSource = R"(
+        #version 330 core
+        uniform float u_Scale;
+        uniform float u_Offsets[4];
+        void main() { gl_Position = vec4(u_Offsets[0] + u_Offsets[3], u_Scale, 0.0, 1.0); }
+    )";
+
+    const char* const s_FragmentSource = R"(
+        #version 330 core
+        out vec4 o_Color;
+        void main() { o_Color = vec4(1.0); }
+    )";
+
+    // Locations written by the SetUniform commands recorded since the last reset
+    std::vector<uint32_t> UploadedLocations(NullRendererAPI& recorder)
+    {
+        std::vector<uint32_t> locations;
+        for (const NullRendererAPI::Command& command : recorder.GetCommands())
+        {
+            if (command.Type == NullRendererAPI::CommandType::SetUniform)
+                locations.push_back(command.Object);
+        }
+        recorder.Reset();
+        return locations;
+    }
+}
+
+TEST(ArrayElementsResolveToTheirOwnLocation)
+{
+    RendererAPI::Create(RendererAPI::API::Null);
+    auto& recorder = static_cast<NullRendererAPI&>(RendererAPI::Get());
+    const Shader shader(s_VertexSource, s_FragmentSource);
+    shader.Use();
+
+    const UniformHandle array = shader.GetUniformHandle("u_Offsets");
+    const UniformHandle first = shader.GetUniformHandle("u_Offsets[0]");
+    const UniformHandle third = shader.GetUniformHandle("u_Offsets[2]");
+    CHECK(array.IsValid() && first.IsValid() && third.IsValid());
+    CHECK(!shader.GetUniformHandle("u_Offsets[4]").IsValid());
+    CHECK(!shader.GetUniformHandle("u_Missing").IsValid());
+    recorder.Reset();
+
+    shader.SetFloat(array, 1.0f);
+    shader.SetFloat("u_Offsets[2]", 3.0f);
+    const std::vector<uint32_t> locations = UploadedLocations(recorder);
+    CHECK(locations.size() == 2);
+    if (locations.size() == 2)
+        CHECK(locations[1] == locations[0] + 2);
+}
+
+TEST(ArrayElementsShareTheArrayShadow)
+{
+    RendererAPI::Create(RendererAPI::API::Null);
+    auto& recorder = static_cast<NullRendererAPI&>(RendererAPI::Get());
+    const Shader shader(s_VertexSource, s_FragmentSource);
+    shader.Use();
+
+    const float values[4] = { 1.0f, 2.0f, 3.0f, 4.0f };
+    shader.SetFloat("u_Offsets[1]", 2.0f);
+    // Nothing before element 1 is known yet, so the whole array must still be uploaded
+    shader.SetIntegerArray("u_Offsets", reinterpret_cast<const int*>(values), 4);
+    // Known now, through the array
+    shader.SetFloat("u_Offsets[3]", 4.0f);
+    CHECK(UploadedLocations(recorder).size() == 2);
+
+    // An element write must be seen by the array: the same values again are uploaded once the element changed
+    shader.SetFloat("u_Offsets[2]", 5.0f);
+    shader.SetIntegerArray("u_Offsets", reinterpret_cast<const int*>(values), 4);
+    CHECK(UploadedLocations(recorder).size() == 2);
+}
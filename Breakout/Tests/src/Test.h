@@ -0,0 +1,24 @@
+#pragma once
+
+#include <Harness.h>
+
+#include <cmath>
+
+// Minimal test runner on top of the shared Harness: a failing CHECK reports its location and lets the case carry on.
+// main exits with the number of failed cases.
+namespace Test
+{
+    // Records a failure of the running case
+    void Fail(const char* expression, const char* file, int line);
+}
+
+#define TEST(name) HARNESS_CASE(name)
+
+#define CHECK(condition)                                            \
+    do                                                              \
+    {                                                               \
+        if (!(condition))                                           \
+            Test::Fail(#condition, __FILE__, __LINE__);             \
+    } while (false)
+
+#define CHECK_NEAR(actual, expected, tolerance) CHECK(std::abs((actual) - (expected)) <= (tolerance))
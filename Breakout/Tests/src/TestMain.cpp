@@ -0,0 +1,39 @@
+// Usage: Tests [name filter]
+
+#include "Test.h"
+
+#include <cstdint>
+#include <iostream>
+
+namespace
+{
+    uint32_t s_Failures = 0;
+}
+
+void Test::Fail(const char* expression, const char* file, const int line)
+{
+    std::cout << "[ERROR] Test: " << file << "(" << line << "): CHECK(" << expression << ") failed" << '\n';
+    s_Failures++;
+}
+
+int main(int argc, char** argv)
+{
+    int failed = 0, run = 0;
+    Harness::RunCases(argc, argv, [&failed, &run](const Harness::Case& testCase)
+    {
+        s_Failures = 0;
+        testCase.Run();
+        run++;
+
+        if (s_Failures > 0)
+        {
+            std::cout << "[ERROR] Test: " << testCase.Name << " failed" << '\n';
+            failed++;
+        }
+        else
+            std::cout << "| [INFO] Test: " << testCase.Name << " passed" << '\n';
+    });
+
+    std::cout << "| [INFO] Test: " << run - failed << "/" << run << " passed" << '\n';
+    return failed;
+}
@@ -0,0 +1,44 @@
+// Atlas builds on the null backend: a failed build must not leave regions pointing at missing pages
+
+#include "Test.h"
+
+#include <Renderer/RendererAPI.h>
+#include <Renderer/TextureAtlas.h>
+
+#include <vector>
+
+TEST(FailedAtlasBuildKeepsThePreviousPages)
+{
+    RendererAPI::Create(RendererAPI::API::Null);
+    const std::vector<unsigned char> pixels(128 * 128 * 4, 255);
+
+    TextureAtlas atlas(64, 1);
+    atlas.Add("small", pixels.data(), 8, 8, 4);
+    CHECK(atlas.Build());
+    CHECK(atlas.GetPageCount() == 1);
+
+    // Checked before anything is packed, even though "first" sorts ahead of the oversized image
+    atlas.Add("first", pixels.data(), 16, 16, 4);
+    atlas.Add("large", pixels.data(), 128, 128, 4);
+    CHECK(!atlas.Build());
+
+    CHECK(atlas.GetPageCount() == 1);
+    CHECK(atlas.GetRegion("first") == nullptr);
+    CHECK(atlas.GetRegion("large") == nullptr);
+    const TextureAtlas::Region* small = atlas.GetRegion("small");
+    CHECK(small != nullptr);
+    if (small != nullptr)
+        CHECK(small->Texture == &atlas.GetPage(small->Page));
+}
+
+TEST(EmptyAtlasImageFailsTheBuild)
+{
+    RendererAPI::Create(RendererAPI::API::Null);
+    const std::vector<unsigned char> pixels(4, 255);
+
+    TextureAtlas atlas(64, 1);
+    atlas.Add("empty", pixels.data(), 0, 1, 4);
+    CHECK(!atlas.Build());
+    CHECK(atlas.GetPageCount() == 0);
+    CHECK(atlas.GetRegion("empty") == nullptr);
+}
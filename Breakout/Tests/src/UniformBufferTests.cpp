@@ -0,0 +1,44 @@
+// Uniform buffer writes must stay within the size the buffer was created with
+
+#include "Test.h"
+
+#include <Renderer/NullRendererAPI.h>
+#include <Renderer/UniformBuffer.h>
+
+#include <cstdint>
+
+namespace
+{
+    constexpr uint32_t BufferSize = 64;
+
+    uint32_t CountUploads(NullRendererAPI& recorder)
+    {
+        uint32_t uploads = 0;
+        for (const NullRendererAPI::Command& command : recorder.GetCommands())
+        {
+            if (command.Type == NullRendererAPI::CommandType::SetBufferSubData)
+                uploads++;
+        }
+        recorder.Reset();
+        return uploads;
+    }
+}
+
+TEST(UniformBufferRejectsWritesPastItsEnd)
+{
+    RendererAPI::Create(RendererAPI::API::Null);
+    auto& recorder = static_cast<NullRendererAPI&>(RendererAPI::Get());
+    const UniformBuffer buffer(BufferSize, UniformBinding::Frame);
+    const unsigned char data[BufferSize + 1] = {};
+    recorder.Reset();
+
+    buffer.SetData(data, BufferSize);
+    buffer.SetData(data, 16, BufferSize - 16);
+    CHECK(CountUploads(recorder) == 2);
+
+    buffer.SetData(data, BufferSize + 1);
+    buffer.SetData(data, 16, BufferSize - 15);
+    // offset + size wraps around to a small number in 32 bits
+    buffer.SetData(data, 16, UINT32_MAX - 8);
+    CHECK(CountUploads(recorder) == 0);
+}